@@ -0,0 +1,125 @@
+#pragma once
+
+// Arc-to-chord generator (no Arduino dependencies, shared with host tools).
+
+#include <math.h>
+#include <stdint.h>
+
+#define ARC_POS_SHIFT  8   // rx/ry carry 8 fractional bits
+#define ARC_COEF_SHIFT 30  // cos/sin of the chord angle in Q30
+
+// Chord end points are rounded to whole steps and the rotation drifts a
+// little between re-anchors; this much of the tolerance is kept for that
+// and the rest goes to the sagitta (steps)
+#define ARC_ROUND_ALLOWANCE 1.0f
+
+/**
+ * @brief State of one arc being cut into chords.
+ *
+ * Chord end points come from an incremental fixed-point rotation (Q30
+ * coefficients, Q8 positions) that is re-anchored with exact sin/cos every
+ * `correction` chords, so float trig runs only a few times per arc. The
+ * last chord always ends on the exact programmed end point. Q15 would save
+ * nothing (the products are 64-bit either way) and lets a radius of 10000
+ * steps drift several steps between re-anchors.
+ */
+struct ArcGen {
+    long     cx, cy;     ///< center (steps)
+    long     endX, endY; ///< exact end point
+    int32_t  rx, ry;     ///< current radius vector, Q8
+    int32_t  cosQ, sinQ; ///< per-chord rotation, Q30
+    float    start;      ///< start angle (rad)
+    float    step;       ///< signed angle per chord (rad)
+    float    radius;     ///< radius (steps)
+    uint16_t index;      ///< chords emitted so far
+    uint16_t count;      ///< total chords
+    uint16_t correction; ///< exact re-anchor every N chords
+    bool     active;     ///< chords still to come
+};
+
+/**
+ * @brief Signed sweep (rad) of the arc from (sx, sy) to (x, y) around
+ * (cx, cy): positive counter-clockwise, negative clockwise. Start == end
+ * gives a full circle.
+ */
+inline float arcSweep(long sx, long sy, long x, long y, long cx, long cy, bool ccw) {
+    float startAngle = atan2((float)(sy - cy), (float)(sx - cx));
+    float endAngle   = atan2((float)(y - cy), (float)(x - cx));
+    float sweep      = endAngle - startAngle;
+    if (ccw) {
+        if (sweep <= 0) sweep += 2 * (float)M_PI;
+    } else {
+        if (sweep >= 0) sweep -= 2 * (float)M_PI;
+    }
+    return sweep;
+}
+
+/**
+ * @brief Sets up g for an arc from (sx, sy) to (x, y) around (cx, cy).
+ *
+ * Chord count comes from the sagitta bound: a chord spanning angle t
+ * deviates R * (1 - cos(t/2)) from the circle, so t = 2 * acos(1 - s/R)
+ * with s = tolerance - ARC_ROUND_ALLOWANCE.
+ */
+inline void arcBegin(ArcGen& g, long sx, long sy, long x, long y, long cx, long cy, bool ccw,
+                     float tolerance, uint16_t correction) {
+    float rx = (float)(sx - cx);
+    float ry = (float)(sy - cy);
+    float sag = tolerance - ARC_ROUND_ALLOWANCE;
+    if (sag < 0.25f * tolerance) sag = 0.25f * tolerance;
+
+    g.cx     = cx;
+    g.cy     = cy;
+    g.endX   = x;
+    g.endY   = y;
+    g.radius = sqrt(rx * rx + ry * ry);
+    g.start  = atan2(ry, rx);
+
+    float sweep   = arcSweep(sx, sy, x, y, cx, cy, ccw);
+    float maxStep = 2 * (float)M_PI;
+    if (g.radius > sag) {
+        maxStep = 2 * acos(1 - sag / g.radius);
+    }
+    g.count = (uint16_t)ceil(fabs(sweep) / maxStep);
+    if (g.count < 1) g.count = 1;
+
+    g.step       = sweep / g.count;
+    g.cosQ       = (int32_t)lround(cos(g.step) * (1L << ARC_COEF_SHIFT));
+    g.sinQ       = (int32_t)lround(sin(g.step) * (1L << ARC_COEF_SHIFT));
+    g.rx         = (int32_t)(rx * (1 << ARC_POS_SHIFT));
+    g.ry         = (int32_t)(ry * (1 << ARC_POS_SHIFT));
+    g.index      = 0;
+    g.correction = correction > 0 ? correction : 1;
+    g.active     = true;
+}
+
+/**
+ * @brief End point of the next chord. Rotates the radius vector by one
+ * chord angle in integer math; every `correction` chords it is recomputed
+ * from the exact angle so rounding drift cannot accumulate. Clears
+ * g.active with the last chord, which ends on the exact end point.
+ */
+inline void arcNext(ArcGen& g, long& x, long& y) {
+    g.index++;
+    if (g.index >= g.count) {
+        g.active = false;
+        x = g.endX;
+        y = g.endY;
+        return;
+    }
+
+    if (g.index % g.correction == 0) {
+        float a = g.start + g.step * g.index;
+        g.rx = (int32_t)(g.radius * cos(a) * (1 << ARC_POS_SHIFT));
+        g.ry = (int32_t)(g.radius * sin(a) * (1 << ARC_POS_SHIFT));
+    } else {
+        int32_t nx = (int32_t)(((int64_t)g.rx * g.cosQ - (int64_t)g.ry * g.sinQ) >> ARC_COEF_SHIFT);
+        int32_t ny = (int32_t)(((int64_t)g.rx * g.sinQ + (int64_t)g.ry * g.cosQ) >> ARC_COEF_SHIFT);
+        g.rx = nx;
+        g.ry = ny;
+    }
+
+    // Round Q8 -> steps
+    x = g.cx + ((g.rx + (1 << (ARC_POS_SHIFT - 1))) >> ARC_POS_SHIFT);
+    y = g.cy + ((g.ry + (1 << (ARC_POS_SHIFT - 1))) >> ARC_POS_SHIFT);
+}
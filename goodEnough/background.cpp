@@ -0,0 +1,65 @@
+#include "functions.h"
+
+/*
+  Background dispatcher (see background.h).
+
+  Items with nothing to do are skipped without being timed, so the LCD
+  estimate only ever sees real transfers. The remote UI cannot tell cheaply
+  whether it has output pending; its floor covers one mirror line. Its input
+  stays in the foreground (fsmUpdate()): a slot for a 250 us item never
+  comes up while an axis cruises at a 100 us step interval.
+*/
+
+struct BgItem {
+    bool     (*pending)();
+    void     (*run)();
+    uint16_t floorUs;  // smallest estimate ever used
+    uint16_t costUs;   // current estimate
+};
+
+static bool lcdPending() { return lcd.staged(); }
+static void lcdChunk()   { lcd.flushStaged(BG_LCD_CHUNK); }
+static bool always()     { return true; }
+
+static BgItem gItems[] = {
+    { lcdPending, lcdChunk,        400, 400 },  // (chunk + 2 addresses) x 4 bytes on I2C
+    { always,     remoteUiOutput,  250, 250 },
+};
+
+#define BG_ITEMS (sizeof(gItems) / sizeof(gItems[0]))
+
+static uint8_t gNextItem = 0;
+
+// Largest recent run time, decaying by 1/8 of the difference per shorter run
+static void updateCost(BgItem& it, unsigned long us) {
+    if (us > 0xffff) {
+        us = 0xffff;
+    }
+    if (us >= it.costUs) {
+        it.costUs = (uint16_t)us;
+    } else {
+        it.costUs -= (it.costUs - (uint16_t)us) >> 3;
+    }
+    if (it.costUs < it.floorUs) {
+        it.costUs = it.floorUs;
+    }
+}
+
+void backgroundService() {
+    unsigned long slack = motionSlackUs();
+    bool unlimited = (slack == MOTION_NO_DEADLINE);
+    unsigned long start = micros();
+
+    for (uint8_t n = 0; n < BG_ITEMS; n++) {
+        BgItem& it = gItems[gNextItem];
+        if (it.pending()) {
+            unsigned long now = micros();
+            if (!unlimited && (now - start) + it.costUs + BG_MARGIN_US > slack) {
+                break;   // does not fit: first in line on the next pass
+            }
+            it.run();
+            updateCost(it, micros() - now);
+        }
+        gNextItem = (gNextItem + 1) % BG_ITEMS;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Dispatcher for work that must never delay a step pulse.
+ *
+ * backgroundService() runs right after motionService() and starts a chunk
+ * of background work only if its estimated cost plus BG_MARGIN_US fits in
+ * the time left before the next step is due (motionSlackUs()). With no
+ * axis moving everything runs at once.
+ *
+ * Work items (round robin, as many per pass as fit):
+ *   - staged LCD rows (lcdPrintLine() during motion), BG_LCD_CHUNK
+ *     characters per transfer
+ *   - the Serial remote UI output (remoteUiOutput(); its input is read in
+ *     the foreground every pass)
+ *
+ * Each item's cost estimate is the largest recent run time, decaying slowly
+ * toward shorter runs but never below its configured floor. Under fast
+ * continuous motion the work may wait until the move ends.
+ */
+
+/**
+ * @brief Runs the background work that fits before the next step. Call
+ * once per loop pass, right after motionService().
+ */
+void backgroundService();
@@ -0,0 +1,116 @@
+#include "functions.h"
+
+/*
+  Position correction table (see correctionMap.h).
+
+  EEPROM layout at CORR_EEPROM_BASE: 'C', CORR_NX, CORR_NY, then the node
+  offsets as int16 dx, dy, row by row (x fastest). A table stored with a
+  different lattice size is ignored.
+*/
+
+#define CORR_BYTES (3 + CORR_NX * CORR_NY * 4)
+
+#if CORR_NX < 2 || CORR_NY < 2
+#error "correction map needs at least 2 x 2 nodes"
+#endif
+#if CORR_EEPROM_BASE + CORR_BYTES > JOB_EEPROM_BASE
+#error "correction map overlaps the job library (raise JOB_EEPROM_BASE)"
+#endif
+
+static int16_t gCorrDx[CORR_NY][CORR_NX];
+static int16_t gCorrDy[CORR_NY][CORR_NX];
+
+bool correctionLoad() {
+    if (EEPROM.read(CORR_EEPROM_BASE) != 'C' ||
+        EEPROM.read(CORR_EEPROM_BASE + 1) != CORR_NX ||
+        EEPROM.read(CORR_EEPROM_BASE + 2) != CORR_NY) {
+        correctionClear();
+        return false;
+    }
+    int addr = CORR_EEPROM_BASE + 3;
+    for (uint8_t iy = 0; iy < CORR_NY; iy++) {
+        for (uint8_t ix = 0; ix < CORR_NX; ix++) {
+            EEPROM.get(addr, gCorrDx[iy][ix]);
+            EEPROM.get(addr + 2, gCorrDy[iy][ix]);
+            addr += 4;
+        }
+    }
+    return true;
+}
+
+void correctionSave() {
+    EEPROM.update(CORR_EEPROM_BASE, 0xff);  // invalid while the table is rewritten
+    int addr = CORR_EEPROM_BASE + 3;
+    for (uint8_t iy = 0; iy < CORR_NY; iy++) {
+        for (uint8_t ix = 0; ix < CORR_NX; ix++) {
+            EEPROM.put(addr, gCorrDx[iy][ix]);
+            EEPROM.put(addr + 2, gCorrDy[iy][ix]);
+            addr += 4;
+        }
+    }
+    EEPROM.update(CORR_EEPROM_BASE + 1, CORR_NX);
+    EEPROM.update(CORR_EEPROM_BASE + 2, CORR_NY);
+    EEPROM.update(CORR_EEPROM_BASE, 'C');   // marker last: a torn save loads as no table
+}
+
+void correctionClear() {
+    memset(gCorrDx, 0, sizeof(gCorrDx));
+    memset(gCorrDy, 0, sizeof(gCorrDy));
+}
+
+void correctionNode(uint8_t ix, uint8_t iy, long& x, long& y) {
+    x = CORR_X0 + (long)ix * CORR_PITCH_X;
+    y = CORR_Y0 + (long)iy * CORR_PITCH_Y;
+}
+
+void correctionSet(uint8_t ix, uint8_t iy, long dx, long dy) {
+    gCorrDx[iy][ix] = (int16_t)constrain(dx, -CORR_MAX, CORR_MAX);
+    gCorrDy[iy][ix] = (int16_t)constrain(dy, -CORR_MAX, CORR_MAX);
+}
+
+/*
+  cellCoord():
+  Splits a coordinate into a cell index and a Q8 fraction within the cell,
+  clamped to the lattice. Works for negative pitches (X runs negative).
+*/
+static void cellCoord(long v, long v0, long pitch, uint8_t nodes, uint8_t& cell, int16_t& frac) {
+    long u = ((v - v0) * 256L) / pitch;
+    if (u < 0) {
+        u = 0;
+    }
+    if (u >= (long)(nodes - 1) * 256L) {
+        cell = nodes - 2;
+        frac = 256;
+        return;
+    }
+    cell = (uint8_t)(u >> 8);
+    frac = (int16_t)(u & 0xff);
+}
+
+// Bilinear blend of the four node values, Q8 x Q8 weights, rounded
+static long blend(int16_t t[CORR_NY][CORR_NX], uint8_t cx, uint8_t cy, int16_t fx, int16_t fy) {
+    long top = (long)t[cy][cx]     * (256 - fx) + (long)t[cy][cx + 1]     * fx;
+    long bot = (long)t[cy + 1][cx] * (256 - fx) + (long)t[cy + 1][cx + 1] * fx;
+    long sum = top * (256 - fy) + bot * fy;
+    return (sum >= 0 ? sum + 32768L : sum - 32768L) / 65536L;
+}
+
+void correctionApply(long& x, long& y) {
+    uint8_t cx, cy;
+    int16_t fx, fy;
+    cellCoord(x, CORR_X0, CORR_PITCH_X, CORR_NX, cx, fx);
+    cellCoord(y, CORR_Y0, CORR_PITCH_Y, CORR_NY, cy, fy);
+
+    long dx = blend(gCorrDx, cx, cy, fx, fy);
+    long dy = blend(gCorrDy, cx, cy, fx, fy);
+    x += dx;
+    y += dy;
+}
+
+void correctionRemove(long& x, long& y) {
+    long cx = x;
+    long cy = y;
+    correctionApply(cx, cy);
+    x -= cx - x;
+    y -= cy - y;
+}
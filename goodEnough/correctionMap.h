@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief 2D position correction table over the bed.
+ *
+ * CORR_NX x CORR_NY nodes on a regular lattice (CORR_X0 / CORR_Y0, pitch
+ * CORR_PITCH_X / CORR_PITCH_Y, motionConfig.h) each hold the offset
+ * (measured - nominal, in steps) the machine needs to land on the nominal
+ * position. correctionApply() interpolates it bilinearly in 8-bit fixed
+ * point and is called once per planned target, so corrected moves cost
+ * nothing per step. Targets outside the lattice use the nearest edge.
+ *
+ * The table is measured with the probe from the main menu (Calibrate Map)
+ * and kept in EEPROM at CORR_EEPROM_BASE. An unmeasured table is all zeros.
+ */
+
+#define CORR_MAX 2000   // largest accepted offset per axis (steps)
+
+/**
+ * @brief Loads the table from EEPROM (zeros if none is stored).
+ * @return true if a stored table was found.
+ */
+bool correctionLoad();
+
+/**
+ * @brief Writes the table to EEPROM.
+ */
+void correctionSave();
+
+/**
+ * @brief Zeroes the table (RAM only until correctionSave()).
+ */
+void correctionClear();
+
+/**
+ * @brief Nominal position of node (ix, iy).
+ */
+void correctionNode(uint8_t ix, uint8_t iy, long& x, long& y);
+
+/**
+ * @brief Sets the offset of node (ix, iy), clamped to +-CORR_MAX.
+ */
+void correctionSet(uint8_t ix, uint8_t iy, long dx, long dy);
+
+/**
+ * @brief Maps a nominal target to the machine position to command.
+ */
+void correctionApply(long& x, long& y);
+
+/**
+ * @brief Maps a commanded machine position back to the nominal target
+ * (one fixed-point step; the offsets change slowly over the bed).
+ */
+void correctionRemove(long& x, long& y);
@@ -0,0 +1,153 @@
+#include "functions.h"
+
+/*
+  Dual-head pairing (see dualHead.h).
+
+  Points are read through a small cursor that walks either the grid
+  (autoGridPoint()) or a stored job (JobReader), always forward. The inner
+  search for a partner starts from a copy of the outer cursor, so planning a
+  job never seeks: n^2 / 2 point decodes, once per run.
+*/
+
+#ifdef HEAD2_PIN
+
+static uint8_t gTaken[DUAL_MAX_POINTS / 8];
+static uint8_t gPaired[DUAL_MAX_POINTS / 8];
+
+static bool bitGet(const uint8_t* bits, uint16_t i) {
+    return i < DUAL_MAX_POINTS && (bits[i >> 3] & (1 << (i & 7)));
+}
+
+static void bitSet(uint8_t* bits, uint16_t i) {
+    bits[i >> 3] |= (1 << (i & 7));
+}
+
+// Forward cursor over the run's points
+struct PointCursor {
+    uint8_t   job;     // JOB_NONE = grid
+    JobReader rd;
+    uint16_t  idx;     // index of the point in x / y
+    uint16_t  count;
+    long      x;
+    long      y;
+};
+
+static bool cursorNext(PointCursor& c) {
+    if ((uint16_t)(c.idx + 1) >= c.count) {
+        return false;
+    }
+    c.idx++;
+    if (c.job == JOB_NONE) {
+        autoGridPoint(c.idx, c.x, c.y);
+        return true;
+    }
+    if (!jobNext(c.rd)) {
+        return false;
+    }
+    c.x = c.rd.x;
+    c.y = c.rd.y;
+    return true;
+}
+
+uint16_t dualHeadPlan(uint8_t job) {
+    memset(gTaken, 0, sizeof(gTaken));
+    memset(gPaired, 0, sizeof(gPaired));
+
+    PointCursor a;
+    a.job = job;
+    a.idx = 0xffff;            // cursorNext() moves to point 0
+    if (job == JOB_NONE) {
+        a.count = AUTO_NUM_X * AUTO_NUM_Y;
+    } else {
+        JobEntry e;
+        if (!jobEntry(job, e) || !jobOpen(job, a.rd)) {
+            return 0;
+        }
+        a.count = e.points;
+    }
+    if (a.count > DUAL_MAX_POINTS) {
+        a.count = DUAL_MAX_POINTS;
+    }
+
+    uint16_t stops = 0;
+    while (cursorNext(a)) {
+        if (bitGet(gTaken, a.idx)) {
+            continue;
+        }
+        stops++;
+
+        long tx = a.x + HEAD2_OFFSET_X;
+        long ty = a.y + HEAD2_OFFSET_Y;
+        PointCursor b = a;
+        while (cursorNext(b)) {
+            if (!bitGet(gTaken, b.idx) &&
+                labs(b.x - tx) <= HEAD2_TOLERANCE && labs(b.y - ty) <= HEAD2_TOLERANCE) {
+                bitSet(gTaken, b.idx);
+                bitSet(gPaired, a.idx);
+                break;
+            }
+        }
+    }
+    return stops;
+}
+
+bool dualHeadTaken(uint16_t idx) {
+    return bitGet(gTaken, idx);
+}
+
+bool dualHeadPartner(uint16_t idx) {
+    return bitGet(gPaired, idx);
+}
+
+void headsDown(float angle, bool both) {
+    probe.moveTo(angle);
+    if (both) {
+        probe2.moveTo(angle);
+    }
+}
+
+void headsUp() {
+    probe.moveTo(PROBE_UP_ANGLE);
+    probe2.moveTo(PROBE_UP_ANGLE);
+}
+
+bool headsSettled(unsigned long settleMs) {
+    return probe.settled(settleMs) && probe2.settled(settleMs);
+}
+
+void headsUpdate() {
+    probe.update();
+    probe2.update();
+}
+
+#else  // single head
+
+uint16_t dualHeadPlan(uint8_t) {
+    return 0;
+}
+
+bool dualHeadTaken(uint16_t) {
+    return false;
+}
+
+bool dualHeadPartner(uint16_t) {
+    return false;
+}
+
+void headsDown(float angle, bool) {
+    probe.moveTo(angle);
+}
+
+void headsUp() {
+    probe.moveTo(PROBE_UP_ANGLE);
+}
+
+bool headsSettled(unsigned long settleMs) {
+    return probe.settled(settleMs);
+}
+
+void headsUpdate() {
+    probe.update();
+}
+
+#endif
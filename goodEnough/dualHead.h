@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Optional second probe head and paired-point scheduling.
+ *
+ * Head 2 sits at a fixed offset (HEAD2_OFFSET_X / HEAD2_OFFSET_Y, steps)
+ * from head 1. Before a point-by-point run, dualHeadPlan() walks the point
+ * list in run order: each point that is not yet taken becomes a stop, and
+ * the first later free point within HEAD2_TOLERANCE of stop + offset is
+ * taken by head 2 of that stop. The sequencer then skips taken points and
+ * lowers both heads at stops that have a partner. The plan depends only on
+ * the point list, so stepping back revisits the same stops.
+ *
+ * Only the first DUAL_MAX_POINTS points take part (one bit each for "taken"
+ * and "has partner"); later points are welded by head 1 alone.
+ * Without HEAD2_PIN (functions.h) there is no second head, nothing is ever
+ * paired and the heads* helpers drive the single probe.
+ */
+
+#define DUAL_MAX_POINTS 128
+
+/**
+ * @brief Pairs the points of a job, or of the compile-time grid (JOB_NONE).
+ * @return Number of stops (0 without a second head).
+ */
+uint16_t dualHeadPlan(uint8_t job);
+
+/**
+ * @brief True if point idx is welded by head 2 at an earlier stop.
+ */
+bool dualHeadTaken(uint16_t idx);
+
+/**
+ * @brief True if head 2 welds a partner point at stop idx.
+ */
+bool dualHeadPartner(uint16_t idx);
+
+// ---------------- Probe heads ----------------
+
+/**
+ * @brief Lowers head 1, and head 2 as well if both is true.
+ */
+void headsDown(float angle, bool both);
+
+/**
+ * @brief Raises every head.
+ */
+void headsUp();
+
+/**
+ * @brief True once every head's move has finished and settled for settleMs.
+ */
+bool headsSettled(unsigned long settleMs);
+
+/**
+ * @brief Advances the head profiles. Call every loop pass.
+ */
+void headsUpdate();
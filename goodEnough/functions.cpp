@@ -1,5 +1,9 @@
 #include "functions.h"
 
+#ifdef LCD_BENCHMARK
+#include <LiquidCrystal_I2C.h>   // legacy backend for lcdBenchmark()
+#endif
+
 /*
   ==============================
   CNC Spot Welder Controller FSM
@@ -18,8 +22,11 @@
       * jog Z via servo (placeholder for a future Z stepper)
 
   Notes for maintainers:
-  - AccelStepper: moveTo()/move() sets a target, run()/runSpeed() must be called frequently.
+  - AccelStepper: moveTo()/move() sets a target; motionService() (called first
+    in fsmUpdate()) steps every axis, so handlers never call run() themselves.
   - Encoder scaling: myEnc.read()/4 assumes your encoder library counts 4 per detent.
+  - Read the encoder/button through encoderCount()/buttonDown() so the Serial
+    remote UI (remoteUi.cpp) can inject input.
   - Button is ACTIVE-LOW: pressed when digitalRead(BUTTON_PIN) == LOW.
 */
 
@@ -31,17 +38,135 @@ static MachineState gState = STATE_MAIN_MENU;
 // Encoder count snapshot used for menu selection and jog delta calculation
 static long gLastEncCount = 0;
 
+// Auto run flavor chosen in the auto menu (false = point-by-point, true = stitch)
+static bool gStitchRun = false;
+
+// Stored job run from the job menu instead of the grid (JOB_NONE = grid)
+static uint8_t gJobRun = JOB_NONE;
+
+// Auto-run stop to continue at after a warm restart (-1 = start from the top)
+static long gResumePoint = -1;
+
+// Probe parameters of the point being processed (grid defaults or job recipe)
+static uint8_t  gProbeDown = PROBE_DOWN_ANGLE;
+static uint8_t  gSettleMs  = PROBE_SETTLE_MS;
+static uint16_t gDwellMs   = 0;   // 0 = wait for the operator
+
+// Input-shaped travel for the X gantry (X1 + X2) and Y (configured in fsmInit())
+static ShapedAxis gShapeX(motorX1, &motorX2);
+static ShapedAxis gShapeY(motorY);
+
+// Acceleration chosen for the current travel move (restored after a band)
+static float gTravelAccelX = X_ACCEL;
+static float gTravelAccelY = Y_ACCEL;
+
+// Current travel keeps both axes on one straight line (KEEPOUT_ZONES): no
+// band acceleration boost, it would pull one axis ahead
+static bool gLineMove = false;
+
+// Nominal (uncorrected) target of the last auto-mode travel move; the
+// machine position differs from it by the correction map
+static long gNomX = 0;
+static long gNomY = 0;
+
 // --------------- Internal helpers (file-local) ---------------
 
 /*
   Print a message on a specific LCD row.
-  Clears the row first by printing 20 spaces (assumes 20x4 LCD).
+  The rest of the row is blanked by padding with spaces, so the whole line
+  goes out as one packed burst (see PackedLcd::printLine()).
 */
 static void lcdPrintLine(uint8_t row, const char* msg) {
-    lcd.setCursor(0, row);
-    lcd.print("                    "); // clear the row (20 spaces)
-    lcd.setCursor(0, row);
-    lcd.print(msg);
+    // While an axis moves the row is staged and sent between steps (background.h)
+    if (motionBusy(MOTION_ALL)) {
+        lcd.stageLine(row, msg);
+        return;
+    }
+    unsigned long t0 = micros();
+    lcd.printLine(row, msg);
+    traceLcd(4 * (LCD_COLUMNS + 1), micros() - t0); // cursor command + full row
+}
+
+// Clear, cursor and blink follow lcdPrintLine(): staged while an axis moves
+// (a clear would hold the loop ~2 ms), direct otherwise
+static void lcdClear() {
+    if (motionBusy(MOTION_ALL)) {
+        lcd.stageClear();
+    } else {
+        lcd.clear();
+    }
+}
+
+static void lcdCursor(uint8_t col, uint8_t row) {
+    if (motionBusy(MOTION_ALL)) {
+        lcd.stageCursor(col, row);
+    } else {
+        lcd.setCursor(col, row);
+    }
+}
+
+static void lcdBlink(bool on) {
+    if (motionBusy(MOTION_ALL)) {
+        lcd.stageBlink(on);
+    } else if (on) {
+        lcd.blink();
+    } else {
+        lcd.noBlink();
+    }
+}
+
+#ifdef LCD_BENCHMARK
+/*
+  lcdBenchmark():
+  Writes the same 20-char line many times with each backend and reports the
+  average cost. The legacy path reproduces the old lcdPrintLine() exactly
+  (setCursor, 20 spaces, setCursor, message).
+*/
+void lcdBenchmark() {
+    const uint8_t lines = 50;
+    const char* msg = "Moving to Position 0";
+
+    unsigned long t0 = micros();
+    for (uint8_t i = 0; i < lines; i++) {
+        lcd.printLine(i & 3, msg);
+    }
+    unsigned long packedUs = (micros() - t0) / lines;
+
+    LiquidCrystal_I2C legacy(I2C_ADDRESS, LCD_COLUMNS, LCD_ROWS);
+    legacy.init();
+    legacy.backlight();
+    t0 = micros();
+    for (uint8_t i = 0; i < lines; i++) {
+        legacy.setCursor(0, i & 3);
+        legacy.print("                    ");
+        legacy.setCursor(0, i & 3);
+        legacy.print(msg);
+    }
+    unsigned long legacyUs = (micros() - t0) / lines;
+
+    lcd.init();   // put the controller back in a known state for PackedLcd
+    lcd.backlight();
+
+    Serial.print("LCD us/line packed: ");
+    Serial.println(packedUs);
+    Serial.print("LCD us/line LiquidCrystal_I2C: ");
+    Serial.println(legacyUs);
+}
+#endif
+
+/*
+  Encoder position in detents (4 counts each), including detents injected
+  over Serial by the remote UI.
+*/
+static long encoderCount() {
+    return myEnc.read() / 4 + remoteEncoderOffset();
+}
+
+/*
+  Raw button state: the real ACTIVE-LOW button or the remote UI's virtual one.
+*/
+static bool buttonDown() {
+    return digitalRead(BUTTON_PIN) == LOW || remoteButtonDown();
 }
 
 /*
@@ -51,12 +176,48 @@ static void lcdPrintLine(uint8_t row, const char* msg) {
 */
 static bool buttonPressedEdge() {
     static bool last = false;                    // last sampled button state
-    bool now = (digitalRead(BUTTON_PIN) == LOW); // current state (pressed == LOW)
+    bool now = buttonDown();                     // current state (pressed)
     bool edge = (!last && now);                  // rising edge: not-pressed -> pressed
     last = now;
     return edge;
 }
 
+/*
+  Click / long-press classification for the pushbutton (non-blocking).
+  - BTN_LONG fires once as soon as the button has been held LONG_PRESS_MS,
+    so the operator gets feedback without having to release.
+  - BTN_CLICK fires on release of a shorter press; presses under
+    CLICK_MIN_MS are treated as contact bounce and ignored.
+  Keeps its own state, independent of buttonPressedEdge().
+*/
+enum ButtonEvent {
+    BTN_NONE = 0,
+    BTN_CLICK,
+    BTN_LONG
+};
+
+static ButtonEvent buttonEvent() {
+    static bool          last     = false; // last sampled button state
+    static bool          longSent = false; // BTN_LONG already reported for this press
+    static unsigned long downAt   = 0;     // millis() when the press started
+
+    bool now = buttonDown();
+    ButtonEvent ev = BTN_NONE;
+
+    if (now && !last) {
+        downAt   = millis();
+        longSent = false;
+    } else if (now && !longSent && millis() - downAt >= LONG_PRESS_MS) {
+        longSent = true;
+        ev = BTN_LONG;
+    } else if (!now && last && !longSent && millis() - downAt >= CLICK_MIN_MS) {
+        ev = BTN_CLICK;
+    }
+
+    last = now;
+    return ev;
+}
+
 /*
   Generic menu selector driven by encoder movement.
   - currentRow: current highlighted row index
@@ -64,7 +225,7 @@ static bool buttonPressedEdge() {
   Returns updated row after applying encoder delta.
 */
 static int updateMenuRow(int currentRow, int maxRows) {
-    long count = myEnc.read() / 4;          // encoder absolute count (scaled)
+    long count = encoderCount();            // encoder absolute count (scaled)
     long delta = count - gLastEncCount;     // how much encoder moved since last update
 
     // Move menu cursor down/up based on encoder direction, clamped to valid rows
@@ -95,13 +256,16 @@ static int updateMenuRow(int currentRow, int maxRows) {
   4) Move off the switches by a fixed number of steps.
 */
 void autoHome() {
-    lcd.clear();
+    lcdClear();
     lcdPrintLine(0, "Homing...");
+    motionWake();         // the search loops below step without motionService()
+    warmSetHomed(false);  // a reset from here on starts cold
 
     // Move Y toward its limit switch using constant speed mode
     motorY.setSpeed(-500);
     while (digitalRead(LIMIT_Y) == LOW) {
         motorY.runSpeed();
+        warmKick();
     }
 
     // Move X toward its limit switch (two motors move together)
@@ -110,27 +274,30 @@ void autoHome() {
     while (digitalRead(LIMIT_X) == LOW) {
         motorX1.runSpeed();
         motorX2.runSpeed();
+        warmKick();
     }
 
-    // Define the limit position as "0" for each axis
+    // Define the limit position as "0" for each axis (on a coarse-valid step)
+    motionAlignHome();
     motorY.setCurrentPosition(0);
     motorX1.setCurrentPosition(0);
     motorX2.setCurrentPosition(0);
 
     // Back off X limit switch so you're not holding the switch mechanically
-    motorX1.move(-300);
-    motorX2.move(-300);
-    while (motorX1.distanceToGo() != 0 || motorX2.distanceToGo() != 0) {
-        motorX1.run();
-        motorX2.run();
+    motionFollow(MOTION_ALL, false);
+    motorX1.move(HOME_BACKOFF_X);
+    motorX2.move(HOME_BACKOFF_X);
+    while (motionBusy(MOTION_X)) {
+        motionService();
     }
 
     // Back off Y limit switch
-    motorY.move(250);
-    while (motorY.distanceToGo() != 0) {
-        motorY.run();
+    motorY.move(HOME_BACKOFF_Y);
+    while (motionBusy(MOTION_Y)) {
+        motionService();
     }
 
+    warmSetHomed(true);
     lcdPrintLine(0, "Homing complete");
     delay(500);
 }
@@ -142,6 +309,8 @@ void autoHome() {
   Displays and navigates the main menu:
     1) Automatic Mode
     2) Manual Mode
+    3) Calibrate Map (position correction table)
+    4) Teach Pattern (step-and-repeat job from jogged points)
 
   Behavior:
   - Uses a static "initialized" to run LCD setup once per entry into this state.
@@ -153,31 +322,38 @@ static void handleMainMenu() {
 
     // One-time entry setup for this state
     if (!initialized) {
-        lcd.clear();
+        lcdClear();
         lcdPrintLine(0, "1. Automatic Mode");
         lcdPrintLine(1, "2. Manual Mode");
-        lcd.setCursor(0, 0);
-        lcd.blink();                      // blink cursor at active row
+        lcdPrintLine(2, "3. Calibrate Map");
+        lcdPrintLine(3, "4. Teach Pattern");
+        lcdCursor(0, 0);
+        lcdBlink(true);                      // blink cursor at active row
         row = 0;
-        gLastEncCount = myEnc.read() / 4; // baseline encoder count for deltas
+        gLastEncCount = encoderCount();   // baseline encoder count for deltas
         initialized = true;
     }
 
     // Update selection row from encoder
-    int newRow = updateMenuRow(row, 2);
+    int newRow = updateMenuRow(row, 4);
     if (newRow != row) {
         row = newRow;
-        lcd.setCursor(0, row);
+        lcdCursor(0, row);
     }
 
     // Select option on button press
     if (buttonPressedEdge()) {
-        lcd.noBlink();
+        lcdBlink(false);
         initialized = false; // force re-init next time we come back here
         if (row == 0) {
+            warmSetHomed(false);         // home once on entry to auto mode
             gState = STATE_AUTO_MENU;    // go to auto menu (and home first in fsmUpdate)
-        } else {
+        } else if (row == 1) {
             gState = STATE_MANUAL_MENU;  // go to manual menu
+        } else if (row == 2) {
+            gState = STATE_CALIBRATE;    // measure the correction table
+        } else {
+            gState = STATE_TEACH;        // teach a step-and-repeat job (homes first)
         }
     }
 }
@@ -193,56 +369,410 @@ enum AutoState {
     AUTO_IDLE = 0,         // initial/reset state
     AUTO_MOVE_X,           // command next X move
     AUTO_WAIT_X,           // wait for X move to finish (run motors)
-    AUTO_MOVE_Y,           // command next Y move
-    AUTO_WAIT_Y,           // wait for Y move to finish (run motor)
-    AUTO_DECISION_MENU     // at a position: lower probe + wait for user decision
+    AUTO_MOVE_Y,           // command the move to the next point (grid row or job point)
+    AUTO_WAIT_Y,           // wait for Y move to finish (run motor), probe starts down
+    AUTO_WAIT_XY,          // job run: wait for both axes, probe starts down
+    AUTO_JOB_NEXT,         // job run: decode the next point and its recipe
+    AUTO_NEXT_POINT,       // raise the probe and advance to the next point
+    AUTO_DWELL,            // job recipe with a dwell: continue on a timer instead of a click
+    AUTO_PROBE_WAIT,       // wait for a profiled probe move to settle, then go to afterProbe
+    AUTO_DECISION_ENTER,   // probe is down: draw the decision menu
+    AUTO_DECISION_MENU,    // at a position: wait for user decision
+    AUTO_DECISION_FAST,    // at a position: click = Continue, hold = open the menu
+    AUTO_STITCH_APPROACH,  // stitch run: move Y to the lead-in point of the column
+    AUTO_STITCH_START,     // stitch run: probe is down, arm triggers and start the sweep
+    AUTO_STITCH_RUN,       // stitch run: Y sweeps the column firing triggers
+    AUTO_WAIT_PATH,        // routed travel around a keep-out zone (keepOutRun())
+    AUTO_WAIT_ARC          // job arc point: arc on the path planner, then AUTO_WAIT_XY
 };
 
+/*
+  autoGridPoint():
+  Same positions the grid run has always used (gridPoint(), motionConfig.h).
+*/
+void autoGridPoint(uint16_t idx, long& x, long& y) {
+    gridPoint(idx, x, y);
+}
+
+// True if head 2 welds every point of grid column xi from other stops
+static bool columnTaken(int xi) {
+    for (int yi = 0; yi < AUTO_NUM_Y; yi++) {
+        if (!dualHeadTaken(xi * AUTO_NUM_Y + yi)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+  startTravel():
+  Commands a travel move to absolute (x, y) in work coordinates. The work
+  origin and then the correction map turn it into the machine position once
+  here, so nothing else (motion, keep-out checks) sees work coordinates.
+  - Clear straight line: the usual per-axis moveTo() targets; the caller's
+    wait state runs the AccelStepper profiles (input-shaped if the axis has
+    a shaper configured). Each axis gets its short-move acceleration if its
+    distance is at most SHORT_MOVE_STEPS, and a cruise speed outside its
+    resonance bands. With KEEPOUT_ZONES the zones were checked against the
+    straight line, so a move on both axes must follow it: the limits are
+    then scaled to each axis' share of the move (bandLineLimits()), as on a
+    routed leg, and both profiles have the same timing.
+  - Line crosses a keep-out zone: the move is routed around it
+    (keepOutRoute()) and AUTO_WAIT_PATH runs the legs, then hands over to the
+    wait state (whose distanceToGo() checks are already satisfied).
+  Returns the next AutoState, or AUTO_IDLE if no safe route exists.
+*/
+static AutoState startTravel(long x, long y, AutoState waitState, AutoState& afterPath) {
+    gNomX = x;
+    gNomY = y;
+    originApply(x, y);
+    correctionApply(x, y);
+
+    long sx = motorX1.currentPosition();
+    long sy = motorY.currentPosition();
+
+    if (!keepOutBlocked(sx, sy, x, y)) {
+        // Acceleration-bound short hops get the short-move acceleration, and
+        // no move cruises inside a resonance band. Only moving axes change;
+        // runAxisX() / runAxisY() put the travel limits back at the end.
+        float ax = profileSelectAccel(x - sx, SHORT_MOVE_STEPS, X_SHORT_ACCEL, X_ACCEL);
+        float ay = profileSelectAccel(y - sy, SHORT_MOVE_STEPS, Y_SHORT_ACCEL, Y_ACCEL);
+        float vx = bandCruiseSpeed(BAND_AXIS_X, x - sx, X_MAX_SPEED, ax);
+        float vy = bandCruiseSpeed(BAND_AXIS_Y, y - sy, Y_MAX_SPEED, ay);
+#ifdef KEEPOUT_ZONES
+        gLineMove = x != sx && y != sy;
+        if (gLineMove) {
+            vx = X_MAX_SPEED;
+            vy = Y_MAX_SPEED;
+            bandLineLimits(x - sx, y - sy, vx, vy, ax, ay);
+        }
+#endif
+        if (x != sx) {
+            motorX1.setAcceleration(ax);
+            motorX2.setAcceleration(ax);
+            motorX1.setMaxSpeed(vx);
+            motorX2.setMaxSpeed(vx);
+            gTravelAccelX = ax;
+        }
+        if (y != sy) {
+            motorY.setAcceleration(ay);
+            motorY.setMaxSpeed(vy);
+            gTravelAccelY = ay;
+        }
+
+        bool shapeX = gShapeX.enabled() && x != sx;
+        bool shapeY = gShapeY.enabled() && y != sy;
+        motionFollow(MOTION_X, shapeX);
+        motionFollow(MOTION_Y, shapeY);
+        if (shapeX) {
+            gShapeX.moveTo(x);
+        }
+        if (shapeY) {
+            gShapeY.moveTo(y);
+        }
+
+        // Plain on both axes: long moves run coarse microsteps for the bulk
+        if (!shapeX && !shapeY) {
+            motionTravel(x, y);
+        } else if (!shapeX) {
+            motorX1.moveTo(x);
+            motorX2.moveTo(x);
+        } else if (!shapeY) {
+            motorY.moveTo(y);
+        }
+
+        // Only plain fine moves are one trapezoid at these limits
+        if (!motionCoarse()) {
+            if (!shapeX) {
+                traceMoveStart('X', x - sx, vx, ax);
+            }
+            if (!shapeY) {
+                traceMoveStart('Y', y - sy, vy, ay);
+            }
+        }
+        return waitState;
+    }
+
+    if (!keepOutRoute(x, y)) {
+        return AUTO_IDLE;
+    }
+    afterPath = waitState;
+    return AUTO_WAIT_PATH;
+}
+
+/*
+  startArc():
+  Job arc point: travels from the previous point to (x, y) on the arc
+  around (cx, cy), on the path planner at ARC_FEED. The arc takes the work
+  origin and is cut where it was programmed; the planner puts every chord
+  end point through the correction map (mapped arc), so the start, the
+  chords and the end all carry their own correction and the arc ends where
+  startTravel() would have gone. The keep-out test uses the arc moved by the
+  end point's correction: the offsets change slowly over the bed, far less
+  than KEEPOUT_MARGIN along one arc. Returns AUTO_WAIT_ARC, or AUTO_IDLE if
+  the arc crosses a keep-out zone.
+*/
+static AutoState startArc(long x, long y, long cx, long cy, bool ccw) {
+    gNomX = x;
+    gNomY = y;
+    originApply(x, y);
+    originApply(cx, cy);
+    long mx = x;
+    long my = y;
+    correctionApply(mx, my);
+
+    long sx = motorX1.currentPosition();
+    long sy = motorY.currentPosition();
+    if (keepOutArcBlocked(sx, sy, mx, my, cx + mx - x, cy + my - y, ccw) ||
+        !pathArc(x, y, cx, cy, ccw, ARC_FEED, true)) {
+        return AUTO_IDLE;
+    }
+    return AUTO_WAIT_ARC;
+}
+
+/*
+  runAxisX() / runAxisY():
+  Advance an auto-mode travel move on one axis, shaped or plain (the steps
+  themselves come from motionService()).
+  Return true while the axis is still moving.
+*/
+// Move done: plain travel limits again for whatever moves the axis next
+static void restoreLimitsX() {
+    motorX1.setAcceleration(X_ACCEL);
+    motorX2.setAcceleration(X_ACCEL);
+    motorX1.setMaxSpeed(X_MAX_SPEED);
+    motorX2.setMaxSpeed(X_MAX_SPEED);
+    gTravelAccelX = X_ACCEL;
+}
+
+static void restoreLimitsY() {
+    motorY.setAcceleration(Y_ACCEL);
+    motorY.setMaxSpeed(Y_MAX_SPEED);
+    gTravelAccelY = Y_ACCEL;
+}
+
+static bool runAxisX() {
+    if (gShapeX.active()) {
+        if (gShapeX.run()) {
+            return true;
+        }
+        motionFollow(MOTION_X, false);   // back to ramped moves (jog, homing)
+        restoreLimitsX();
+        return false;
+    }
+    if (!motionCoarse() && !gLineMove) {   // bands and accelerations are in fine steps
+        bandServiceAccel(motorX1, BAND_AXIS_X, gTravelAccelX);
+        bandServiceAccel(motorX2, BAND_AXIS_X, gTravelAccelX);
+    }
+    if (motionBusy(MOTION_X)) {
+        return true;
+    }
+    restoreLimitsX();
+    traceMoveEnd('X');
+    return false;
+}
+
+static bool runAxisY() {
+    if (gShapeY.active()) {
+        if (gShapeY.run()) {
+            return true;
+        }
+        motionFollow(MOTION_Y, false);
+        restoreLimitsY();
+        return false;
+    }
+    if (!motionCoarse() && !gLineMove) {
+        bandServiceAccel(motorY, BAND_AXIS_Y, gTravelAccelY);
+    }
+    if (motionBusy(MOTION_Y)) {
+        return true;
+    }
+    restoreLimitsY();
+    traceMoveEnd('Y');
+    return false;
+}
+
+/*
+  probeMayDescend():
+  Early-descent check for the Y approach move that is still running.
+  Plain AccelStepper moves: remaining time is bounded from above by
+  2 * distance / speed. Whatever the rest of the profile does (cruise,
+  accelerate, decelerate), it ends linearly at zero speed, so its average
+  speed is at least half the current one.
+  Coarse travel: d / v bounds the coarse part only; the switch back and the
+  fine tail (a few steps from rest, the first one c0 long) follow, so their
+  bound motionTailMs() is added.
+  Shaped moves: the remaining time is known exactly from the shaped profile.
+  Using these bounds means the probe, whose profiled descent takes a known
+  travel time, cannot touch before the axis has stopped.
+*/
+static bool probeMayDescend() {
+    long  d;
+    float arrivalMs;
+
+    if (gShapeY.active()) {
+        d = abs(gShapeY.target() - motorY.currentPosition());
+        arrivalMs = gShapeY.remainingMs();
+    } else {
+        d = abs(motorY.distanceToGo());   // coarse or fine: only d / v is used
+        if (d == 0) {
+            return !motionBusy(MOTION_Y);   // not between coarse and fine parts
+        }
+        float v = fabs(motorY.speed());
+        if (v < 1.0) {
+            return false;                   // just starting, no estimate yet
+        }
+        arrivalMs = 2000.0 * d / v + motionTailMs(MOTION_Y);
+    }
+
+    if (arrivalMs > probe.travelMs(PROBE_UP_ANGLE, gProbeDown)) {
+        return false;
+    }
+    return (PROBE_EARLY_STEPS > 0 && d <= PROBE_EARLY_STEPS) ||
+           (PROBE_EARLY_MS > 0 && arrivalMs <= PROBE_EARLY_MS);
+}
+
+/*
+  applyRecipe():
+  Takes the probe angle, settle time and dwell for the next job point(s).
+*/
+static void applyRecipe(uint8_t idx) {
+    JobRecipe r;
+    if (jobGetRecipe(idx, r)) {
+        gProbeDown = r.probeDown;
+        gSettleMs  = r.settleMs;
+        gDwellMs   = r.dwellMs;
+    }
+}
+
+/*
+  pointLabel():
+  Position text for the auto-run status line: grid cell, or point number
+  within the stored job.
+*/
+static String pointLabel(int xIndex, int yIndex, const JobReader& rd, uint16_t points) {
+    if (gJobRun != JOB_NONE) {
+        return "P=" + String(points - rd.left) + "/" + String(points);
+    }
+    return "X=" + String(xIndex) + " Y=" + String(yIndex);
+}
+
 /*
   handleAutoMenu():
   Small menu shown before auto run:
-    1) Start
-    2) Go Back
+    1) Start         (stop at each point, decision menu)
+    2) Stitch Start  (weld each column on the fly)
+    3) Run Job       (stored job from the EEPROM library)
+    4) Go Back
 */
 static void handleAutoMenu() {
     static bool initialized = false;
     static int  row = 0;
 
     if (!initialized) {
-        lcd.clear();
+        lcdClear();
         lcdPrintLine(0, "1. Start");
-        lcdPrintLine(1, "2. Go Back");
-        lcd.setCursor(0, 0);
-        lcd.blink();
+        lcdPrintLine(1, "2. Stitch Start");
+        lcdPrintLine(2, "3. Run Job");
+        lcdPrintLine(3, "4. Go Back");
+        lcdCursor(0, 0);
+        lcdBlink(true);
         row = 0;
-        gLastEncCount = myEnc.read() / 4;
+        gLastEncCount = encoderCount();
         initialized = true;
     }
 
-    int newRow = updateMenuRow(row, 2);
+    int newRow = updateMenuRow(row, 4);
     if (newRow != row) {
         row = newRow;
-        lcd.setCursor(0, row);
+        lcdCursor(0, row);
     }
 
     if (buttonPressedEdge()) {
-        lcd.noBlink();
+        lcdBlink(false);
         initialized = false;
-        if (row == 0) {
+        if (row == 0 || row == 1) {
+            gStitchRun = (row == 1);
+            gJobRun    = JOB_NONE;
             gState = STATE_AUTO_RUN;   // start the auto sub-FSM
+        } else if (row == 2) {
+            gState = STATE_JOB_MENU;   // pick a stored job
         } else {
             gState = STATE_MAIN_MENU;  // return to main menu
         }
     }
 }
 
+/*
+  handleJobMenu():
+  Job picker for the EEPROM library. The encoder scrolls through the stored
+  jobs (one per screen, with point count and free space); click runs the
+  shown job, long press goes back to the auto menu.
+*/
+static void handleJobMenu() {
+    static bool    initialized = false;
+    static uint8_t idx = 0;
+    static bool    redraw = true;
+    static bool    armed = false;  // the press that opened the menu has been released
+
+    uint8_t n = jobCount();
+
+    if (!initialized) {
+        lcdClear();
+        lcdPrintLine(0, "Select Job");
+        lcdPrintLine(3, "Click=Run Hold=Back");
+        idx = 0;
+        redraw = true;
+        armed = false;
+        gLastEncCount = encoderCount();
+        initialized = true;
+    }
+
+    long count = encoderCount();
+    long delta = count - gLastEncCount;
+    gLastEncCount = count;
+    if (delta > 0 && idx + 1 < n) { idx++; redraw = true; }
+    if (delta < 0 && idx > 0)     { idx--; redraw = true; }
+
+    if (redraw) {
+        JobEntry e;
+        if (jobEntry(idx, e)) {
+            char name[JOB_NAME_LEN + 1];
+            memcpy(name, e.name, JOB_NAME_LEN);
+            name[JOB_NAME_LEN] = '\0';
+            lcdPrintLine(1, String(String(idx + 1) + "/" + String(n) + " " + name).c_str());
+            lcdPrintLine(2, String(String(e.points) + " pts " + String(jobFreeBytes()) + "B free").c_str());
+        } else {
+            lcdPrintLine(1, "No jobs stored");
+            lcdPrintLine(2, "");
+        }
+        redraw = false;
+    }
+
+    ButtonEvent ev = buttonEvent();
+    if (!armed) {
+        armed = !buttonDown();
+        ev = BTN_NONE;
+    }
+    if (ev == BTN_CLICK && idx < n) {
+        initialized = false;
+        gStitchRun = false;
+        gJobRun    = idx;
+        gState     = STATE_AUTO_RUN;
+    } else if (ev == BTN_LONG) {
+        buttonPressedEdge(); // sync edge detector: the long press is still held
+        initialized = false;
+        gState = STATE_AUTO_MENU;
+    }
+}
+
 /*
   handleAutoRun():
   Runs the automatic positioning sequence using the AutoState sub-FSM.
 
   Important details:
   - xIndex and yIndex represent which grid cell you are in.
-  - X motion: currently always moves by -500 steps per column (relative).
+  - X motion: currently always moves by AUTO_X_STEP steps per column (relative).
   - Y motion: uses moveTo() with a target derived from yIndex and Y_MOVE.
   - At each (xIndex, yIndex) position:
       1) move there
@@ -251,8 +781,26 @@ static void handleAutoMenu() {
           - Continue: raise probe, go to next Y
           - Back: raise probe, go to previous position
           - Exit: raise probe, return to main menu
-
-  NOTE: There are still short delay() calls around servo moves.
+  - With AUTO_FAST_DECISION the menu is skipped: a click means Continue and
+    a long press opens the full menu. The screen keeps a fixed layout and
+    only row 1 (position + status) is rewritten per point.
+  - Probe moves are profiled (ServoProfile); AUTO_PROBE_WAIT waits for the
+    move to finish plus PROBE_SETTLE_MS before anything else moves.
+  - Stitch run (gStitchRun): instead of stopping at each row, the probe is
+    lowered once per column and Y sweeps through all rows at STITCH_SPEED.
+    motorY fires WELD_TRIGGER_PIN from its step code as it crosses each row
+    position, so the welds land on the same targets as the point-by-point run.
+  - Travel that would cross a keep-out zone (KEEPOUT_ZONES) is routed around
+    it on the path planner, blending through the detour corners.
+  - Job arc points (jobAddArc()) are reached on their arc through the path
+    planner when the run comes straight from the point before.
+  - Job run (gJobRun): the points come from the EEPROM job library instead of
+    the grid, decoded one at a time by a JobReader; each point's recipe sets
+    the probe angle, settle time and an optional dwell that continues without
+    a click. Back re-decodes the job up to the previous point.
+  - Second head (HEAD2_PIN): point-by-point runs are paired up front
+    (dualHeadPlan()); points taken by head 2 are skipped, and stops with a
+    partner lower both heads. Back goes to the previous stop.
 */
 static void handleAutoRun() {
     static AutoState autoState = AUTO_IDLE;
@@ -263,6 +811,28 @@ static void handleAutoRun() {
     static int  menuRow = 0;  // 0=Continue, 1=Back, 2=Exit
     static long lastEnc = 0;  // encoder baseline for decision menu
 
+    // Row positions for the stitch trigger list (must outlive the pass)
+    static long stitchTargets[AUTO_NUM_Y];
+
+    // Where to continue once a routed (keep-out) travel move finishes
+    static AutoState afterPath = AUTO_IDLE;
+
+    // Where to continue once the probe has settled (AUTO_IDLE = leave auto mode)
+    static AutoState afterProbe = AUTO_IDLE;
+
+    // Fast-decision layout is on screen (only row 1 needs updating)
+    static bool fastScreen = false;
+    // Long press asked for the full menu at this point
+    static bool menuRequested = false;
+
+    // Job run: streaming decoder, job length and dwell start
+    static JobReader     jobRd;
+    static uint16_t      jobPoints = 0;
+    static unsigned long dwellStart = 0;
+
+    // Head 2 welds a partner point at the current stop
+    static bool pairStop = false;
+
     // Entry/reset for automatic run
     if (autoState == AUTO_IDLE) {
         // Set speed limits for runSpeed/run() behavior (AccelStepper)
@@ -273,11 +843,51 @@ static void handleAutoRun() {
         // Start at the first cell in the grid
         xIndex = 0;
         yIndex = 0;
+        gNomX  = motorX1.currentPosition() - originX();   // work coordinates
+        gNomY  = motorY.currentPosition() - originY();
 
-        lcd.clear();
+        lcdClear();
         lcdPrintLine(0, "Starting Auto Mode");
+        fastScreen = false;
+
+        // Grid defaults; a job run takes these from each point's recipe
+        gProbeDown = PROBE_DOWN_ANGLE;
+        gSettleMs  = PROBE_SETTLE_MS;
+        gDwellMs   = 0;
+
+        uint8_t resumeJob = gJobRun;
+        JobEntry e;
+        if (gJobRun != JOB_NONE && jobEntry(gJobRun, e) && jobOpen(gJobRun, jobRd)) {
+            char name[JOB_NAME_LEN + 1];
+            memcpy(name, e.name, JOB_NAME_LEN);
+            name[JOB_NAME_LEN] = '\0';
+            traceRunStart(name);
+            jobPoints = e.points;
+            autoState = AUTO_JOB_NEXT;
+        } else {
+            traceRunStart(gStitchRun ? "STITCH" : "GRID");
+            gJobRun   = JOB_NONE;
+            autoState = AUTO_MOVE_X;
+        }
 
-        autoState = AUTO_MOVE_X;
+        // Warm restart mid-run: straight back to the interrupted stop
+        if (gResumePoint >= 0 && resumeJob == gJobRun) {
+            if (gJobRun != JOB_NONE && jobSeek(gJobRun, gResumePoint, jobRd)) {
+                applyRecipe(jobRd.recipe);
+                autoState = AUTO_MOVE_Y;
+            } else if (gJobRun == JOB_NONE && gResumePoint < AUTO_NUM_X * AUTO_NUM_Y) {
+                xIndex    = gResumePoint / AUTO_NUM_Y;
+                yIndex    = gResumePoint % AUTO_NUM_Y;
+                autoState = AUTO_MOVE_Y;
+            }
+        }
+        gResumePoint = -1;
+
+        // Pair points for the second head (stitch runs always use head 1 only)
+        if (!gStitchRun && dualHeadPlan(gJobRun) > 0) {
+            lcdPrintLine(1, "Heads paired");
+        }
+        pairStop = false;
     }
 
     switch (autoState) {
@@ -285,34 +895,111 @@ static void handleAutoRun() {
     // ----------------------------
     // MOVE X (start of a new column)
     // ----------------------------
-    case AUTO_MOVE_X:
+    case AUTO_MOVE_X: {
+        // Columns whose points head 2 welds from other stops need no visit
+        while (!gStitchRun && xIndex < AUTO_NUM_X && columnTaken(xIndex)) {
+            xIndex++;
+        }
+
         // Done when we've processed all X columns
         if (xIndex >= AUTO_NUM_X) {
-            lcd.clear();
+            lcdClear();
             lcdPrintLine(0, "Auto Complete");
+            traceRunEnd();
             delay(500);
             autoState = AUTO_IDLE;
             gState = STATE_MAIN_MENU;
             break;
         }
 
-        // Command a relative X move (both motors together)
-        motorX1.move(-500);
-        motorX2.move(-500);
-        autoState = AUTO_WAIT_X;
+        // Command the next column: X moves to the column (both motors together)
+        long colX, rowY;
+        autoGridPoint(xIndex * AUTO_NUM_Y, colX, rowY);
+        autoState = startTravel(colX, gNomY, AUTO_WAIT_X, afterPath);
+        if (autoState == AUTO_IDLE) {
+            lcdClear();
+            lcdPrintLine(0, "No safe route");
+            traceRunEnd();
+            delay(1000);
+            gState = STATE_MAIN_MENU;
+        }
         break;
+    }
 
     // Wait until both X motors reach their target
     case AUTO_WAIT_X:
-        motorX1.run();
-        motorX2.run();
-
-        if (motorX1.distanceToGo() == 0 &&
-            motorX2.distanceToGo() == 0) {
+        if (!runAxisX()) {
 
             // After reaching new X column, start Y at the first row
             yIndex = 0;
             autoState = AUTO_MOVE_Y;
+
+            if (gStitchRun) {
+                // Same targets as AUTO_MOVE_Y. Only their Y correction can be
+                // applied: X stays put for the whole sweep.
+                for (int i = 0; i < AUTO_NUM_Y; i++) {
+                    long cx = gNomX;
+                    long cy = (long)((i + 1) * Y_MOVE);
+                    originApply(cx, cy);
+                    correctionApply(cx, cy);
+                    stitchTargets[i] = cy;
+                }
+                autoState = AUTO_STITCH_APPROACH;
+
+                // The approach runs outside startTravel() and the sweep has
+                // the probe down: the whole column line must be clear
+                long x     = motorX1.currentPosition();
+                long y     = motorY.currentPosition();
+                long start = stitchTargets[0] - STITCH_RAMP - STITCH_LEAD_IN;
+                long end   = stitchTargets[AUTO_NUM_Y - 1] + STITCH_RAMP + STITCH_OVERTRAVEL;
+                if (keepOutBlocked(x, min(y, start), x, max(y, end))) {
+                    lcdClear();
+                    lcdPrintLine(0, "Zone in stitch path");
+                    traceRunEnd();
+                    delay(1000);
+                    autoState = AUTO_IDLE;
+                    gState = STATE_MAIN_MENU;
+                }
+            }
+        }
+        break;
+
+    // ----------------------------
+    // STITCH RUN (whole column on the fly)
+    // ----------------------------
+    case AUTO_STITCH_APPROACH:
+        if (motorY.targetPosition() != stitchTargets[0] - STITCH_RAMP - STITCH_LEAD_IN) {
+            lcdClear();
+            lcdPrintLine(0, "Stitch Column");
+            lcdPrintLine(1, String("X=" + String(xIndex)).c_str());
+            motorY.moveTo(stitchTargets[0] - STITCH_RAMP - STITCH_LEAD_IN);
+        }
+        if (motorY.distanceToGo() == 0) {
+            probe.moveTo(gProbeDown); // probe down for the whole pass
+            afterProbe = AUTO_STITCH_START;
+            autoState  = AUTO_PROBE_WAIT;
+        }
+        break;
+
+    case AUTO_STITCH_START:
+        motorY.loadTriggers(stitchTargets, AUTO_NUM_Y, WELD_TRIGGER_PIN, TRIGGER_PULSE_US);
+        motorY.setMaxSpeed(STITCH_SPEED);
+        motorY.setAcceleration(STITCH_ACCEL);
+        motorY.moveTo(stitchTargets[AUTO_NUM_Y - 1] + STITCH_RAMP + STITCH_OVERTRAVEL);
+        autoState = AUTO_STITCH_RUN;
+        break;
+
+    case AUTO_STITCH_RUN:
+        motorY.serviceTriggers();
+        if (motorY.distanceToGo() == 0 && motorY.triggersDone()) {
+            motorY.clearTriggers();
+            motorY.setMaxSpeed(Y_MAX_SPEED); // back to the travel limits
+            motorY.setAcceleration(Y_ACCEL);
+
+            probe.moveTo(PROBE_UP_ANGLE); // raise probe before the next column
+            xIndex++;
+            afterProbe = AUTO_MOVE_X;
+            autoState  = AUTO_PROBE_WAIT;
         }
         break;
 
@@ -320,51 +1007,220 @@ static void handleAutoRun() {
     // MOVE Y (one row in current column)
     // ----------------------------
     case AUTO_MOVE_Y: {
+        // Rows taken by head 2 at an earlier stop are skipped
+        while (gJobRun == JOB_NONE && yIndex < AUTO_NUM_Y &&
+               dualHeadTaken(xIndex * AUTO_NUM_Y + yIndex)) {
+            yIndex++;
+        }
+
         // If finished all Y rows in this column, advance to next X column
-        if (yIndex >= AUTO_NUM_Y) {
+        if (gJobRun == JOB_NONE && yIndex >= AUTO_NUM_Y) {
             xIndex++;
             autoState = AUTO_MOVE_X;
             break;
         }
+        pairStop = dualHeadPartner(gJobRun != JOB_NONE ? jobPoints - jobRd.left - 1
+                                                       : xIndex * AUTO_NUM_Y + yIndex);
 
         // UI status
-        lcd.clear();
-        lcdPrintLine(0, "Moving to Position");
-        lcdPrintLine(1, String("X=" + String(xIndex) + " Y=" + String(yIndex)).c_str());
+        if (AUTO_FAST_DECISION && !gStitchRun) {
+            if (!fastScreen) {
+                lcdClear();
+                lcdPrintLine(0, "Auto Mode");
+                lcdPrintLine(3, "Click=Next Hold=Menu");
+                fastScreen = true;
+            }
+            // Row 1 is written once per point, on arrival (AUTO_DECISION_ENTER)
+        } else {
+            lcdClear();
+            lcdPrintLine(0, "Moving to Position");
+            lcdPrintLine(1, pointLabel(xIndex, yIndex, jobRd, jobPoints).c_str());
+        }
+
+        if (gJobRun != JOB_NONE && jobRd.arc && jobRd.sx == gNomX && jobRd.sy == gNomY) {
+            // Arc point straight from the point before it (after Back, a
+            // resume or a point head 2 took, the arc start is elsewhere)
+            autoState = startArc(jobRd.x, jobRd.y, jobRd.cx, jobRd.cy, jobRd.ccw);
+        } else if (gJobRun != JOB_NONE) {
+            // Job point: both axes may move
+            autoState = startTravel(jobRd.x, jobRd.y, AUTO_WAIT_XY, afterPath);
+        } else {
+            // Grid point: normally Y only, X too after Back into the previous column
+            long x, y;
+            autoGridPoint(xIndex * AUTO_NUM_Y + yIndex, x, y);
+            autoState = startTravel(x, y, x != gNomX ? AUTO_WAIT_XY : AUTO_WAIT_Y, afterPath);
+        }
+        if (autoState == AUTO_IDLE) {
+            lcdClear();
+            lcdPrintLine(0, "No safe route");
+            traceRunEnd();
+            delay(1000);
+            gState = STATE_MAIN_MENU;
+        }
+        break;
+    }
 
-        // Compute next Y target (absolute). (yIndex+1) means first move goes to 1*Y_MOVE.
-        long yTarget = (long)((yIndex + 1) * Y_MOVE);
-        motorY.moveTo(yTarget);
+    // Routed travel: path legs around keep-out zones
+    case AUTO_WAIT_PATH:
+        if (!keepOutRun()) {
+            autoState = afterPath;
+        }
+        break;
 
-        autoState = AUTO_WAIT_Y;
+    // Job arc: chords at ARC_FEED, then the usual arrival (probe, menu)
+    case AUTO_WAIT_ARC:
+        if (!pathRun()) {
+            autoState = AUTO_WAIT_XY;
+        }
+        break;
+
+    // Wait until Y is at target, then lower probe and show decision menu.
+    // The probe may start down during the final deceleration (probeMayDescend),
+    // in which case only the rest of its travel time is waited out here.
+    case AUTO_WAIT_Y: {
+        bool yMoving = runAxisY();
+        if (probe.target() != gProbeDown && probeMayDescend()) {
+            headsDown(gProbeDown, pairStop);
+        }
+        if (!yMoving) {
+            if (!probe.done() && !AUTO_FAST_DECISION) {
+                lcdClear();
+                lcdPrintLine(0, "Lowering Probe...");
+            }
+            afterProbe = AUTO_DECISION_ENTER;
+            autoState  = AUTO_PROBE_WAIT;
+        }
         break;
     }
 
-    // Wait until Y is at target, then lower probe and show decision menu
-    case AUTO_WAIT_Y:
-        motorY.run();
-        if (motorY.distanceToGo() == 0) {
+    // Move on both axes (job point, or Back into the previous column):
+    // same as AUTO_WAIT_Y, but early descent only once X has arrived
+    case AUTO_WAIT_XY: {
+        bool xMoving = runAxisX();
+        bool yMoving = runAxisY();
+        if (!xMoving && probe.target() != gProbeDown && probeMayDescend()) {
+            headsDown(gProbeDown, pairStop);
+        }
+        if (!xMoving && !yMoving) {
+            if (!probe.done() && !AUTO_FAST_DECISION) {
+                lcdClear();
+                lcdPrintLine(0, "Lowering Probe...");
+            }
+            afterProbe = AUTO_DECISION_ENTER;
+            autoState  = AUTO_PROBE_WAIT;
+        }
+        break;
+    }
+
+    // ----------------------------
+    // JOB RUN (points from the EEPROM library)
+    // ----------------------------
+    case AUTO_JOB_NEXT: {
+        // Points taken by head 2 at an earlier stop are skipped
+        bool more;
+        do {
+            more = jobNext(jobRd);
+        } while (more && dualHeadTaken(jobPoints - jobRd.left - 1));
+
+        if (!more) {
+            lcdClear();
+            lcdPrintLine(0, "Auto Complete");
+            traceRunEnd();
+            delay(500);
+            autoState = AUTO_IDLE;
+            gState = STATE_MAIN_MENU;
+            break;
+        }
+        applyRecipe(jobRd.recipe);
+        autoState = AUTO_MOVE_Y;
+        break;
+    }
 
-            // Lower probe (servo down)
-            lcd.clear();
-            lcdPrintLine(0, "Lowering Probe...");
-            servo.write(135); // down angle (adjust for your linkage)
-            delay(150);
+    // Probe move in progress: nothing else moves until it has settled
+    case AUTO_PROBE_WAIT:
+        if (headsSettled(gSettleMs)) {
+            autoState = afterProbe;
+            if (afterProbe == AUTO_IDLE) {
+                traceRunEnd();
+                gState = STATE_MAIN_MENU;
+            }
+        }
+        break;
 
-            // Show decision menu (3 options)
-            lcd.clear();
-            lcdPrintLine(0, "1. Continue");
-            lcdPrintLine(1, "2. Back");
-            lcdPrintLine(2, "3. Exit");
-            lcd.setCursor(0, 0);
-            lcd.blink();
+    case AUTO_DECISION_ENTER:
+        warmSetRunPoint(gJobRun, gJobRun != JOB_NONE ? jobPoints - jobRd.left - 1
+                                                     : xIndex * AUTO_NUM_Y + yIndex);
+        if (gDwellMs > 0 && !menuRequested) {
+            if (!fastScreen) {
+                lcdClear();
+                lcdPrintLine(0, "Auto Mode");
+                lcdPrintLine(3, "Hold=Menu");
+                fastScreen = true;
+            }
+            lcdPrintLine(1, String(pointLabel(xIndex, yIndex, jobRd, jobPoints) + " dwell").c_str());
+            dwellStart = millis();
+            autoState  = AUTO_DWELL;
+            break;
+        }
+        if (AUTO_FAST_DECISION && !menuRequested) {
+            lcdPrintLine(1, String(pointLabel(xIndex, yIndex, jobRd, jobPoints) +
+                                   (pairStop ? " ready x2" : " ready")).c_str());
+            autoState = AUTO_DECISION_FAST;
+            break;
+        }
+
+        // Show decision menu (3 options)
+        menuRequested = false;
+        fastScreen    = false;
+        lcdClear();
+        lcdPrintLine(0, "1. Continue");
+        lcdPrintLine(1, "2. Back");
+        lcdPrintLine(2, "3. Exit");
+        lcdCursor(0, 0);
+        lcdBlink(true);
+
+        // Initialize decision menu state
+        menuRow = 0;
+        lastEnc = encoderCount();
+
+        autoState = AUTO_DECISION_MENU;
+        break;
+
+    // One gesture per point: click continues, long press opens the menu
+    case AUTO_DECISION_FAST: {
+        ButtonEvent ev = buttonEvent();
+
+        if (ev == BTN_CLICK) {
+            autoState = AUTO_NEXT_POINT; // same as "1. Continue"
+        } else if (ev == BTN_LONG) {
+            buttonPressedEdge(); // sync edge detector: the long press is still held
+            menuRequested = true;
+            autoState = AUTO_DECISION_ENTER;
+        }
+        break;
+    }
 
-            // Initialize decision menu state
-            menuRow = 0;
-            lastEnc = myEnc.read() / 4;
+    // Recipe dwell: continue on the timer; a long press still opens the menu
+    case AUTO_DWELL:
+        if (buttonEvent() == BTN_LONG) {
+            buttonPressedEdge();
+            menuRequested = true;
+            autoState = AUTO_DECISION_ENTER;
+        } else if (millis() - dwellStart >= gDwellMs) {
+            autoState = AUTO_NEXT_POINT;
+        }
+        break;
 
-            autoState = AUTO_DECISION_MENU;
+    // Continue: raise the probe, then move to the next grid row / job point
+    case AUTO_NEXT_POINT:
+        headsUp();
+        if (gJobRun != JOB_NONE) {
+            afterProbe = AUTO_JOB_NEXT;
+        } else {
+            yIndex++;
+            afterProbe = AUTO_MOVE_Y;
         }
+        autoState = AUTO_PROBE_WAIT;
         break;
 
     // ----------------------------------------
@@ -372,7 +1228,7 @@ static void handleAutoRun() {
     // ----------------------------------------
     case AUTO_DECISION_MENU: {
         // Encoder-driven selection (0..2)
-        long count = myEnc.read() / 4;
+        long count = encoderCount();
         long delta = count - lastEnc;
 
         if (delta > 0 && menuRow < 2) menuRow++;
@@ -381,42 +1237,49 @@ static void handleAutoRun() {
         lastEnc = count;
 
         // Move cursor to selected option
-        lcd.setCursor(0, menuRow);
+        lcdCursor(0, menuRow);
 
         // Execute option on button press
         if (buttonPressedEdge()) {
-            lcd.noBlink();
+            lcdBlink(false);
 
             // OPTION 1: Continue forward to next Y position
             if (menuRow == 0) {
-                servo.write(90); // raise probe
-                delay(150);
-
-                yIndex++;
-                autoState = AUTO_MOVE_Y;
+                autoState = AUTO_NEXT_POINT;
             }
 
-            // OPTION 2: Go back one position (previous Y; or previous X column last Y)
+            // OPTION 2: Go back one stop (previous Y; or previous X column last Y;
+            // previous job point), skipping points welded by head 2
             else if (menuRow == 1) {
-                servo.write(90);
-                delay(150);
-
-                if (yIndex > 0) {
-                    yIndex--;
-                } else if (xIndex > 0) {
-                    xIndex--;
-                    yIndex = AUTO_NUM_Y - 1;
+                headsUp();
+
+                if (gJobRun != JOB_NONE) {
+                    uint16_t cur  = jobPoints - jobRd.left - 1;
+                    uint16_t prev = cur;
+                    while (prev > 0 && (prev == cur || dualHeadTaken(prev))) {
+                        prev--;
+                    }
+                    jobSeek(gJobRun, prev, jobRd);
+                    applyRecipe(jobRd.recipe);
+                } else {
+                    int cur  = xIndex * AUTO_NUM_Y + yIndex;
+                    int prev = cur;
+                    while (prev > 0 && (prev == cur || dualHeadTaken(prev))) {
+                        prev--;
+                    }
+                    xIndex = prev / AUTO_NUM_Y;
+                    yIndex = prev % AUTO_NUM_Y;
                 }
-                autoState = AUTO_MOVE_Y;
+                afterProbe = AUTO_MOVE_Y;
+                autoState  = AUTO_PROBE_WAIT;
             }
 
             // OPTION 3: Exit auto mode back to main menu
             else if (menuRow == 2) {
-                servo.write(90);
-                delay(150);
+                headsUp();
 
-                autoState = AUTO_IDLE;
-                gState = STATE_MAIN_MENU;
+                afterProbe = AUTO_IDLE;    // main menu once the probe is up
+                autoState  = AUTO_PROBE_WAIT;
             }
         }
 
@@ -432,6 +1295,14 @@ static void handleAutoRun() {
 
 // ---------------- Manual menu + jog FSM ----------------
 
+// X / Y jog screens move one grid pitch per detent instead of JOG_STEP_*
+static bool gJogGrid = false;
+
+static void manualAxisRows() {
+    lcdPrintLine(0, gJogGrid ? "1. X-Axis (grid)" : "1. X-Axis");
+    lcdPrintLine(1, gJogGrid ? "2. Y-Axis (grid)" : "2. Y-Axis");
+}
+
 /*
   handleManualMenu():
   Manual menu:
@@ -439,32 +1310,44 @@ static void handleAutoRun() {
     2) Y-Axis jog
     3) Z-Axis jog (servo)
     4) Go Back
+  Click selects; a long press switches the X / Y jogs between fine steps
+  and grid nodes.
 */
 static void handleManualMenu() {
     static bool initialized = false;
+    static bool armed = false;
     static int  row = 0;
 
     if (!initialized) {
-        lcd.clear();
-        lcdPrintLine(0, "1. X-Axis");
-        lcdPrintLine(1, "2. Y-Axis");
+        lcdClear();
+        manualAxisRows();
         lcdPrintLine(2, "3. Z-Axis");
         lcdPrintLine(3, "4. Go Back");
-        lcd.setCursor(0, 0);
-        lcd.blink();
+        lcdCursor(0, 0);
+        lcdBlink(true);
         row = 0;
-        gLastEncCount = myEnc.read() / 4;
+        armed = false;
+        gLastEncCount = encoderCount();
         initialized = true;
     }
 
     int newRow = updateMenuRow(row, 4);
     if (newRow != row) {
         row = newRow;
-        lcd.setCursor(0, row);
+        lcdCursor(0, row);
     }
 
-    if (buttonPressedEdge()) {
-        lcd.noBlink();
+    ButtonEvent ev = buttonEvent();
+    if (!armed) {
+        armed = !buttonDown();   // the press that opened the menu
+        ev = BTN_NONE;
+    }
+    if (ev == BTN_LONG) {
+        gJogGrid = !gJogGrid;
+        manualAxisRows();
+        lcdCursor(0, row);
+    } else if (ev == BTN_CLICK) {
+        lcdBlink(false);
         initialized = false;
         switch (row) {
         case 0: gState = STATE_JOG_X;     break;
@@ -475,44 +1358,140 @@ static void handleManualMenu() {
     }
 }
 
+/*
+  jogButton():
+  Button handling shared by the X / Y jog screens: a click leaves, a long
+  press makes the current position the work origin (axes at rest only).
+  The press that opened the screen is ignored until released.
+  Returns true to leave the screen.
+*/
+static bool jogButton(bool& armed) {
+    ButtonEvent ev = buttonEvent();
+    if (!armed) {
+        armed = !buttonDown();
+        return false;
+    }
+    if (ev == BTN_LONG) {
+        if (motionBusy(MOTION_ALL)) {
+            lcdPrintLine(3, "Wait for stop");
+        } else {
+            originSetHere();
+            lcdPrintLine(3, String("Origin " + String(originX()) + "," + String(originY())).c_str());
+        }
+    }
+    return ev == BTN_CLICK;
+}
+
+/*
+  gridNode():
+  Grid position of column / row i along X (axis 0) or Y (axis 1), work
+  coordinates, same formula as autoGridPoint().
+*/
+static long gridNode(uint8_t axis, long i) {
+    return axis == 0 ? HOME_BACKOFF_X + (i + 1) * AUTO_X_STEP : (long)((i + 1) * Y_MOVE);
+}
+
+/*
+  gridJog():
+  Grid jog on X (axis 0) or Y (axis 1): moves node index idx by delta
+  detents and returns the machine target of the new node on that axis
+  (work origin and correction map applied at the other axis' position).
+  At rest idx is taken from the current position: within GRID_SNAP_TOL of
+  a node counts as on it, otherwise the first detent stops at the next
+  node in its direction. While the move runs idx just accumulates, so
+  detents turned meanwhile retarget the same move instead of queueing
+  short ones. A detent moves the same way as in fine jog; idx stays on
+  the grid, and detents away from it are ignored outside it.
+*/
+static long gridJog(uint8_t axis, long delta, long& idx) {
+    long x = motorX1.currentPosition();
+    long y = motorY.currentPosition();
+    originRemove(x, y);
+
+    float pitch = axis == 0 ? (float)AUTO_X_STEP : (float)Y_MOVE;
+    long  count = axis == 0 ? AUTO_NUM_X : AUTO_NUM_Y;
+    long  step  = pitch > 0 ? delta : -delta;   // detents in index units
+
+    if (!motionBusy(axis == 0 ? MOTION_X : MOTION_Y)) {
+        long  w = axis == 0 ? x : y;
+        float f = (w - gridNode(axis, 0)) / pitch;
+        long  n = lround(f);
+        if (labs(w - gridNode(axis, n)) <= GRID_SNAP_TOL) {
+            idx = n + step;
+        } else if (step > 0) {
+            idx = (long)ceil(f) + step - 1;
+        } else {
+            idx = (long)floor(f) + step + 1;
+        }
+        idx = constrain(idx, 0L, count - 1);
+        if ((step > 0 && idx < f) || (step < 0 && idx > f)) {
+            // outside the grid, turning away from it: stay
+            return axis == 0 ? motorX1.currentPosition() : motorY.currentPosition();
+        }
+    } else {
+        idx = constrain(idx + step, 0L, count - 1);
+    }
+
+    if (axis == 0) {
+        x = gridNode(0, idx);
+    } else {
+        y = gridNode(1, idx);
+    }
+    originApply(x, y);
+    correctionApply(x, y);
+    return axis == 0 ? x : y;
+}
+
 /*
   handleJogX():
   Manual jog for X.
-  - Encoder delta changes a target position in steps of JOG_STEP_X.
+  - Encoder delta changes a target position in steps of JOG_STEP_X, or in
+    grid mode by whole grid columns (gridJog()) at full speed.
   - Both X motors are commanded to the same target position.
-  - run() must be called continuously to advance motion.
+  - motionService() advances the motors toward the target.
 */
 static void handleJogX() {
     static bool initialized = false;
+    static bool armed = false;
     static long targetPos = 0;
+    static long col = 0;
 
     if (!initialized) {
-        lcd.clear();
-        lcdPrintLine(0, "Jog X (enc)");
-        lcdPrintLine(1, "Button = Back");
+        lcdClear();
+        lcdPrintLine(0, gJogGrid ? "Jog X grid (enc)" : "Jog X (enc)");
+        if (gJogGrid) {
+            motorX1.setMaxSpeed(X_MAX_SPEED);
+            motorX2.setMaxSpeed(X_MAX_SPEED);
+            motorX1.setAcceleration(X_ACCEL);
+            motorX2.setAcceleration(X_ACCEL);
+        }
+        lcdPrintLine(1, "Click = Back");
+        lcdPrintLine(2, "Hold = Set origin");
 
         targetPos = motorX1.currentPosition(); // start from current X position
-        gLastEncCount = myEnc.read() / 4;
+        gLastEncCount = encoderCount();
+        armed = false;
         initialized = true;
     }
 
-    long count = myEnc.read() / 4;
+    long count = encoderCount();
     long delta = count - gLastEncCount;
     gLastEncCount = count;
 
     // Update commanded target when encoder moves
     if (delta != 0) {
-        targetPos += delta * JOG_STEP_X;
+        if (gJogGrid) {
+            targetPos = gridJog(0, delta, col);
+            lcdPrintLine(3, String("Column " + String(col + 1) + "/" + String(AUTO_NUM_X)).c_str());
+        } else {
+            targetPos += delta * JOG_STEP_X;
+        }
         motorX1.moveTo(targetPos);
         motorX2.moveTo(targetPos);
     }
 
-    // Advance motors toward target
-    motorX1.run();
-    motorX2.run();
-
     // Exit back to manual menu
-    if (buttonPressedEdge()) {
+    if (jogButton(armed)) {
         initialized = false;
         gState = STATE_MANUAL_MENU;
     }
@@ -521,35 +1500,47 @@ static void handleJogX() {
 /*
   handleJogY():
   Manual jog for Y.
-  - Encoder delta changes a target position in steps of JOG_STEP_Y.
-  - motorY moves to target using moveTo()/run().
+  - Encoder delta changes a target position in steps of JOG_STEP_Y, or in
+    grid mode by whole grid rows (gridJog()) at full speed.
+  - motorY moves to target using moveTo() (stepped by motionService()).
 */
 static void handleJogY() {
     static bool initialized = false;
+    static bool armed = false;
     static long targetPos = 0;
+    static long row = 0;
 
     if (!initialized) {
-        lcd.clear();
-        lcdPrintLine(0, "Jog Y (enc)");
-        lcdPrintLine(1, "Button = Back");
+        lcdClear();
+        lcdPrintLine(0, gJogGrid ? "Jog Y grid (enc)" : "Jog Y (enc)");
+        if (gJogGrid) {
+            motorY.setMaxSpeed(Y_MAX_SPEED);
+            motorY.setAcceleration(Y_ACCEL);
+        }
+        lcdPrintLine(1, "Click = Back");
+        lcdPrintLine(2, "Hold = Set origin");
 
         targetPos = motorY.currentPosition();
-        gLastEncCount = myEnc.read() / 4;
+        gLastEncCount = encoderCount();
+        armed = false;
         initialized = true;
     }
 
-    long count = myEnc.read() / 4;
+    long count = encoderCount();
     long delta = count - gLastEncCount;
     gLastEncCount = count;
 
     if (delta != 0) {
-        targetPos += delta * JOG_STEP_Y;
+        if (gJogGrid) {
+            targetPos = gridJog(1, delta, row);
+            lcdPrintLine(3, String("Row " + String(row + 1) + "/" + String(AUTO_NUM_Y)).c_str());
+        } else {
+            targetPos += delta * JOG_STEP_Y;
+        }
         motorY.moveTo(targetPos);
     }
 
-    motorY.run();
-
-    if (buttonPressedEdge()) {
+    if (jogButton(armed)) {
         initialized = false;
         gState = STATE_MANUAL_MENU;
     }
@@ -564,43 +1555,412 @@ static void handleJogY() {
 */
 static void handleJogZ() {
     static bool initialized = false;
+    static bool armed = false;
     static long lastCount = 0;
     static int angle = 90; // neutral starting angle
 
     if (!initialized) {
-        lcd.clear();
+        lcdClear();
         lcdPrintLine(0, "Jog Z (Servo)");
-        lcdPrintLine(1, "Rotate encoder");
-        lcdPrintLine(2, "Button = Back");
+        lcdPrintLine(1, "Click = Back");
+        lcdPrintLine(2, "Hold = Clear origin");
 
-        lastCount = myEnc.read() / 4;
+        lastCount = encoderCount();
+        armed = false;
         initialized = true;
     }
 
-    long count = myEnc.read() / 4;
+    long count = encoderCount();
     long delta = count - lastCount;
     lastCount = count;
 
     if (delta != 0) {
         angle += (int)delta;         // 1 degree per encoder tick
         angle = constrain(angle, 0, 180);
-        servo.write(angle);
+        probe.moveTo(angle);
     }
 
-    if (buttonPressedEdge()) {
+    ButtonEvent ev = buttonEvent();
+    if (!armed) {
+        armed = !buttonDown();   // the press that opened this screen
+        ev = BTN_NONE;
+    }
+    if (ev == BTN_LONG) {
+        originClear();
+        lcdPrintLine(3, "Origin cleared");
+    } else if (ev == BTN_CLICK) {
         initialized = false;
         gState = STATE_MANUAL_MENU;
     }
 }
 
+// ---------------- Correction map calibration ----------------
+
+// Abort: drop the pending targets so motionService() brings the axes to rest
+static void stopAxes() {
+    motorX1.moveTo(motorX1.currentPosition());
+    motorX2.moveTo(motorX2.currentPosition());
+    motorY.moveTo(motorY.currentPosition());
+}
+
+/*
+  handleCalibrate():
+  Measures the position correction table node by node.
+  - The probe lifts, the axes travel to the node's nominal position and the
+    probe drops to CORR_PROBE_ANGLE, just above the part, as a pointer.
+  - The encoder jogs X until the tip is on the node's mark; click switches
+    to Y; the next click stores the jogged offset and goes to the next node.
+  - After the last node the table is saved to EEPROM. A long press aborts
+    and restores the stored table.
+*/
+enum CalState {
+    CAL_START = 0,
+    CAL_LIFT,    // raise the probe before travelling
+    CAL_MOVE,    // travel to the node's nominal position
+    CAL_LOWER,   // probe down to the hover angle
+    CAL_JOG      // operator jogs X, then Y, onto the mark
+};
+
+// Top line: node number and what the operator / machine is doing
+static void calHeader(uint8_t node, const char* what) {
+    lcdPrintLine(0, String("Node " + String(node + 1) + "/" + String(CORR_NX * CORR_NY) + " " + what).c_str());
+}
+
+static void handleCalibrate() {
+    static CalState calState = CAL_START;
+    static uint8_t  node = 0;
+    static uint8_t  axis = 0;      // 0 = jogging X, 1 = jogging Y
+    static long     nomX = 0;      // node's nominal position
+    static long     nomY = 0;
+    static long     jogX = 0;      // jogged position
+    static long     jogY = 0;
+
+    ButtonEvent ev = buttonEvent(); // sampled every pass so a held press is never stale
+
+    switch (calState) {
+    case CAL_START:
+        node = 0;
+        motorX1.setAcceleration(X_ACCEL);
+        motorX2.setAcceleration(X_ACCEL);
+        motorY.setAcceleration(Y_ACCEL);
+        motorX1.setMaxSpeed(X_MAX_SPEED);
+        motorX2.setMaxSpeed(X_MAX_SPEED);
+        motorY.setMaxSpeed(Y_MAX_SPEED);
+        calState = CAL_LIFT;
+        break;
+
+    case CAL_LIFT:
+        if (probe.target() != PROBE_UP_ANGLE) {
+            probe.moveTo(PROBE_UP_ANGLE);
+        }
+        if (probe.settled(PROBE_SETTLE_MS)) {
+            correctionNode(node % CORR_NX, node / CORR_NX, nomX, nomY);
+            lcdClear();
+            calHeader(node, "moving");
+            motorX1.moveTo(nomX);
+            motorX2.moveTo(nomX);
+            motorY.moveTo(nomY);
+            calState = CAL_MOVE;
+        }
+        break;
+
+    case CAL_MOVE:
+        if (motorX1.distanceToGo() == 0 && motorX2.distanceToGo() == 0 && motorY.distanceToGo() == 0) {
+            probe.moveTo(CORR_PROBE_ANGLE);
+            calState = CAL_LOWER;
+        }
+        break;
+
+    case CAL_LOWER:
+        if (probe.settled(PROBE_SETTLE_MS)) {
+            jogX = nomX;
+            jogY = nomY;
+            axis = 0;
+            gLastEncCount = encoderCount();
+            calHeader(node, "jog X");
+            lcdPrintLine(1, "dX=0 dY=0");
+            lcdPrintLine(3, "Click=Next Hold=Quit");
+            ev = BTN_NONE;
+            calState = CAL_JOG;
+        }
+        break;
+
+    case CAL_JOG: {
+        long count = encoderCount();
+        long delta = count - gLastEncCount;
+        gLastEncCount = count;
+        if (delta != 0) {
+            if (axis == 0) {
+                jogX += delta * JOG_STEP_X;
+                motorX1.moveTo(jogX);
+                motorX2.moveTo(jogX);
+            } else {
+                jogY += delta * JOG_STEP_Y;
+                motorY.moveTo(jogY);
+            }
+            lcdPrintLine(1, String("dX=" + String(jogX - nomX) + " dY=" + String(jogY - nomY)).c_str());
+        }
+
+        if (ev == BTN_CLICK && axis == 0) {
+            axis = 1;
+            calHeader(node, "jog Y");
+        } else if (ev == BTN_CLICK) {
+            correctionSet(node % CORR_NX, node / CORR_NX, jogX - nomX, jogY - nomY);
+            node++;
+            if (node >= CORR_NX * CORR_NY) {
+                correctionSave();
+                probe.moveTo(PROBE_UP_ANGLE);
+                lcdClear();
+                lcdPrintLine(0, "Map saved");
+                delay(1000);
+                calState = CAL_START;
+                gState = STATE_MAIN_MENU;
+            } else {
+                calState = CAL_LIFT;
+            }
+        }
+        break;
+    }
+    }
+
+    if (ev == BTN_LONG) {
+        buttonPressedEdge(); // sync edge detector: the long press is still held
+        correctionLoad();    // drop the partly measured table
+        stopAxes();
+        probe.moveTo(PROBE_UP_ANGLE);
+        calState = CAL_START;
+        gState = STATE_MAIN_MENU;
+    }
+}
+
+// ---------------- Step-and-repeat teaching ----------------
+
+/*
+  storePattern():
+  Writes an nx x ny step-and-repeat pattern as a new job "PATn" (first
+  free n). Point (i, j) is p0 + i * u + j * v with u / v the pitch vectors
+  along X / Y, so a skewed or rotated part is followed. Points go column
+  by column like the grid. Returns the job index, or JOB_NONE if the
+  library is full.
+*/
+static uint8_t storePattern(const long p0[2], const long u[2], const long v[2], uint8_t nx, uint8_t ny) {
+    String name;
+    uint8_t n = 1;
+    for (; n <= JOB_MAX_JOBS; n++) {
+        name = "PAT" + String(n);
+        if (jobFind(name.c_str()) == JOB_NONE) {
+            break;
+        }
+    }
+    if (n > JOB_MAX_JOBS || !jobBegin(name.c_str(), 0)) {   // never replace an old pattern
+        return JOB_NONE;
+    }
+    for (uint8_t i = 0; i < nx; i++) {
+        for (uint8_t j = 0; j < ny; j++) {
+            jobAddPoint(p0[0] + (long)i * u[0] + (long)j * v[0],
+                        p0[1] + (long)i * u[1] + (long)j * v[1]);
+        }
+    }
+    return jobEnd();
+}
+
+/*
+  handleTeach():
+  Teaches a step-and-repeat pattern without editing functions.h.
+  - Jog onto the first point, then the next point along X, then the next
+    point along Y: the encoder jogs X, click switches to Y, the next click
+    takes the point once the axes have stopped.
+  - Enter the X and Y counts with the encoder, click to accept each.
+  - The pitch vectors are the differences to the first point; the pattern
+    is stored as a job (Automatic Mode > Select Job runs it). Points are in
+    work coordinates, so a later origin shifts them like the grid.
+  A long press aborts.
+*/
+enum TeachState {
+    TEACH_START = 0,
+    TEACH_JOG,     // operator jogs onto the current point
+    TEACH_COUNT    // operator enters the X, then the Y repeat count
+};
+
+static const char* const kTeachPoint[3] = { "1st pt", "next X", "next Y" };
+
+static void handleTeach() {
+    static TeachState teachState = TEACH_START;
+    static uint8_t    point = 0;     // 0 = first, 1 = next along X, 2 = next along Y
+    static uint8_t    axis = 0;      // 0 = X, 1 = Y (jog axis or count being entered)
+    static long       jogX = 0;
+    static long       jogY = 0;
+    static long       taught[3][2];  // the three points, work coordinates
+    static uint8_t    count[2];      // repeats along X, along Y
+    static bool       redraw = true;
+    static bool       armed = false;
+
+    ButtonEvent ev = buttonEvent();
+    if (!armed) {
+        armed = !buttonDown();   // the press that opened this screen
+        ev = BTN_NONE;
+    }
+
+    long enc   = encoderCount();
+    long delta = enc - gLastEncCount;
+    gLastEncCount = enc;
+
+    switch (teachState) {
+    case TEACH_START:
+        motorX1.setAcceleration(X_ACCEL);
+        motorX2.setAcceleration(X_ACCEL);
+        motorY.setAcceleration(Y_ACCEL);
+        motorX1.setMaxSpeed(X_MAX_SPEED);
+        motorX2.setMaxSpeed(X_MAX_SPEED);
+        motorY.setMaxSpeed(Y_MAX_SPEED);
+        jogX   = motorX1.currentPosition();
+        jogY   = motorY.currentPosition();
+        point  = 0;
+        axis   = 0;
+        redraw = true;
+        lcdClear();
+        lcdPrintLine(3, "Click=Next Hold=Quit");
+        teachState = TEACH_JOG;
+        break;
+
+    case TEACH_JOG:
+        if (delta != 0) {
+            if (axis == 0) {
+                jogX += delta * JOG_STEP_X;
+                motorX1.moveTo(jogX);
+                motorX2.moveTo(jogX);
+            } else {
+                jogY += delta * JOG_STEP_Y;
+                motorY.moveTo(jogY);
+            }
+            redraw = true;
+        }
+
+        if (ev == BTN_CLICK && axis == 0) {
+            axis   = 1;
+            redraw = true;
+        } else if (ev == BTN_CLICK && motionBusy(MOTION_ALL)) {
+            lcdPrintLine(2, "Wait for stop");
+        } else if (ev == BTN_CLICK) {
+            taught[point][0] = motorX1.currentPosition();
+            taught[point][1] = motorY.currentPosition();
+            originRemove(taught[point][0], taught[point][1]);
+            lcdPrintLine(2, "");
+            point++;
+            axis   = 0;
+            redraw = true;
+            if (point == 3) {
+                count[0] = 1;
+                count[1] = 1;
+                lcdPrintLine(1, "");
+                teachState = TEACH_COUNT;
+                break;
+            }
+        }
+
+        if (redraw) {
+            long wx = jogX;
+            long wy = jogY;
+            originRemove(wx, wy);
+            lcdPrintLine(0, String("Teach " + String(kTeachPoint[point]) + (axis == 0 ? ": jog X" : ": jog Y")).c_str());
+            lcdPrintLine(1, String("X=" + String(wx) + " Y=" + String(wy)).c_str());
+            redraw = false;
+        }
+        break;
+
+    case TEACH_COUNT:
+        if (delta != 0) {
+            count[axis] = (uint8_t)constrain((long)count[axis] + delta, 1L, (long)TEACH_MAX_COUNT);
+            redraw = true;
+        }
+
+        if (ev == BTN_CLICK && axis == 0) {
+            axis   = 1;
+            redraw = true;
+        } else if (ev == BTN_CLICK) {
+            long u[2] = { taught[1][0] - taught[0][0], taught[1][1] - taught[0][1] };
+            long v[2] = { taught[2][0] - taught[0][0], taught[2][1] - taught[0][1] };
+            uint8_t idx = storePattern(taught[0], u, v, count[0], count[1]);
+            JobEntry e;
+            lcdClear();
+            if (idx != JOB_NONE && jobEntry(idx, e)) {
+                char name[JOB_NAME_LEN + 1];
+                memcpy(name, e.name, JOB_NAME_LEN);
+                name[JOB_NAME_LEN] = '\0';
+                lcdPrintLine(0, String(String("Saved ") + name).c_str());
+                lcdPrintLine(1, String(String(e.points) + " pts").c_str());
+            } else {
+                lcdPrintLine(0, "Job library full");
+            }
+            delay(1000);
+            armed = false;
+            teachState = TEACH_START;
+            gState = STATE_MAIN_MENU;
+            break;
+        }
+
+        if (redraw) {
+            lcdPrintLine(0, axis == 0 ? "Count along X" : "Count along Y");
+            lcdPrintLine(1, String(String(count[0]) + " x " + String(count[1]) + " = " +
+                                   String(count[0] * count[1]) + " pts").c_str());
+            redraw = false;
+        }
+        break;
+    }
+
+    if (ev == BTN_LONG) {
+        buttonPressedEdge(); // sync edge detector: the long press is still held
+        stopAxes();
+        armed = false;
+        teachState = TEACH_START;
+        gState = STATE_MAIN_MENU;
+    }
+}
+
 // ---------------- FSM public API ----------------
 
+/*
+  seedGridJob():
+  Stores the compile-time grid as job "GRID" (same points as the grid run
+  after autoHome()), so a fresh library has something to run and copy.
+*/
+static void seedGridJob() {
+    if (!jobBegin("GRID", 0)) {
+        return;
+    }
+    for (uint16_t i = 0; i < AUTO_NUM_X * AUTO_NUM_Y; i++) {
+        long x, y;
+        autoGridPoint(i, x, y);
+        jobAddPoint(x, y);
+    }
+    jobEnd();
+}
+
 /*
   fsmInit():
   Call once in setup() to start the FSM at the main menu.
 */
 void fsmInit() {
+    gShapeX.configure(X_SHAPER_TYPE, X_SHAPER_FREQ, X_SHAPER_DAMPING);
+    gShapeY.configure(Y_SHAPER_TYPE, Y_SHAPER_FREQ, Y_SHAPER_DAMPING);
+
+    if (!jobLibraryInit()) {
+        seedGridJob();     // blank EEPROM
+    }
+    correctionLoad();
+    originLoad();
+
     gState = STATE_MAIN_MENU;
+
+    // Warm restart in the middle of a point-by-point run: continue it
+    uint8_t  job;
+    uint16_t idx;
+    if (warmRunPoint(job, idx)) {
+        gJobRun      = job;
+        gStitchRun   = false;
+        gResumePoint = idx;
+        gState       = STATE_AUTO_RUN;
+    }
 }
 
 /*
@@ -609,13 +1969,32 @@ void fsmInit() {
   Dispatches to the correct handler based on the current top-level state.
 */
 void fsmUpdate() {
+    warmService();       // stored positions stale before a move's first step
+    motionService();     // steps every axis that is due; the handlers only set targets
+    remoteUiInput();     // remote keys and button release, every pass (cheap)
+    backgroundService(); // staged LCD rows + remote UI output, in the slack before the next step
+    headsUpdate();       // profiled probe servo command(s), advanced every pass in every state
+    traceService();      // timing trace (TIMING_TRACE only)
+
+    // Drivers may power down only while a menu waits for the operator; jog,
+    // calibration and auto runs hold position
+    bool menu = (gState == STATE_MAIN_MENU || gState == STATE_MANUAL_MENU ||
+                 gState == STATE_JOB_MENU);
+    motionIdleTimeout(menu ? MOTOR_IDLE_MS : 0);   // positions stay valid (motionService.h)
+
+    if (gState != STATE_AUTO_RUN) {
+        warmClearRun();  // run finished or left: a reset now lands in the menu
+    }
+
     switch (gState) {
     case STATE_MAIN_MENU:
         handleMainMenu();
         break;
 
     case STATE_AUTO_MENU:
-        autoHome();        // NOTE: blocking homing; consider making this non-blocking later
+        if (!warmHomed()) {
+            autoHome();    // NOTE: blocking homing; consider making this non-blocking later
+        }
         handleAutoMenu();
         break;
 
@@ -623,6 +2002,10 @@ void fsmUpdate() {
         handleAutoRun();
         break;
 
+    case STATE_JOB_MENU:
+        handleJobMenu();
+        break;
+
     case STATE_MANUAL_MENU:
         handleManualMenu();
         break;
@@ -639,6 +2022,17 @@ void fsmUpdate() {
         handleJogZ();
         break;
 
+    case STATE_CALIBRATE:
+        handleCalibrate();
+        break;
+
+    case STATE_TEACH:
+        if (!warmHomed()) {
+            autoHome();    // taught points are relative to the homed zero
+        }
+        handleTeach();
+        break;
+
     default:
         gState = STATE_MAIN_MENU;
         break;
@@ -4,12 +4,47 @@
 #include <AccelStepper.h>
 #include <Encoder.h>
 #include <Wire.h>
-#include <LiquidCrystal_I2C.h>
 #include <Servo.h>
+#include "motionConfig.h"
+#include "profile.h"
+#include "arcGen.h"
+#include "packedLcd.h"
+#include "triggerStepper.h"
+#include "pathPlanner.h"
+#include "keepOut.h"
+#include "servoProfile.h"
+#include "shapedAxis.h"
+#include "speedBands.h"
+#include "remoteUi.h"
+#include "jobLibrary.h"
+#include "timingTrace.h"
+#include "correctionMap.h"
+#include "dualHead.h"
+#include "motionService.h"
+#include "background.h"
+#include "warmStart.h"
+#include "workOrigin.h"
 
 // ---------------- Pin / HW defs ----------------
 
-#define ENABLE_PIN 8
+#define ENABLE_PIN 8   // shared by all three drivers, active LOW
+
+// Driver power (motionService.h): in menus the drivers are switched off after
+// MOTOR_IDLE_MS without motion and switched back on before the next move
+#define MOTOR_IDLE_MS 10000
+#define MOTOR_WAKE_US 2000    // enable to first step (driver charge pump / current ramp)
+
+// Microstep switching (motionService.h): MS1 + MS3 of all drivers on one pin,
+// MS2 tied high: HIGH = 1/16 (ONE_TURN steps per turn), LOW = 1/4. Long plain
+// travel moves run the bulk coarse and the last part fine. Leave undefined
+// with fixed 1/16 wiring.
+// #define MICROSTEP_PIN 17
+#define MICROSTEP_RATIO     4     // fine steps per coarse step
+#define MICROSTEP_MIN_STEPS 800   // shortest travel (fine steps) that goes coarse
+// Top speed of the coarse part (fine steps/s): the same pulse rate moves
+// MICROSTEP_RATIO times faster, so this may exceed X_MAX_SPEED / Y_MAX_SPEED
+#define MICROSTEP_SPEED_X   20000
+#define MICROSTEP_SPEED_Y   25000
 
 #define MOTOR_X1_STEP_PIN 2
 #define MOTOR_X1_DIR_PIN  5
@@ -20,7 +55,29 @@
 
 #define SERVO_PIN 11
 
+// Probe servo angles and profile limits: motionConfig.h
+#define PROBE_SETTLE_MS   20    // dwell after the profile ends before moving on
+// Early descent: start lowering while Y is still decelerating into a point.
+// Triggers when |distanceToGo| <= PROBE_EARLY_STEPS or the predicted arrival
+// time <= PROBE_EARLY_MS, but never while arrival could be later than the
+// probe's profiled travel time (it must not reach the part before motion stops).
+#define PROBE_EARLY_STEPS 0     // 0 = distance trigger off
+#define PROBE_EARLY_MS    120   // 0 = time trigger off
+
+// Optional second probe head (dualHead.h) at a fixed offset from the first.
+// Point-by-point runs pair points that match the offset and weld both in
+// one stop. The Servo library drives any pin, so D13 works.
+// #define HEAD2_PIN       13
+#define HEAD2_OFFSET_X  0       // head 2 position minus head 1 position (steps)
+#define HEAD2_OFFSET_Y  323     // e.g. 3 grid rows (3 * Y_MOVE)
+#define HEAD2_TOLERANCE 3       // max mismatch for a pair (steps)
+
+// Weld trigger output (pulsed by TriggerStepper during stitch runs)
+#define WELD_TRIGGER_PIN 12
+
 #define BUTTON_PIN 14
+#define LONG_PRESS_MS 600   // hold time that counts as a long press
+#define CLICK_MIN_MS  30    // shorter presses are treated as contact bounce
 #define ENC_CW     15
 #define ENC_CCW    16
 
@@ -28,34 +85,99 @@
 #define LCD_COLUMNS 20
 #define I2C_ADDRESS 0x27
 
-#define LIMIT_Y 10
-#define LIMIT_X 9
+// Uncomment to print LCD timing (us per 20-char line) to Serial at startup
+// #define LCD_BENCHMARK
+
+// Uncomment to print move / probe / LCD / loop timings of every auto run to
+// Serial for calibrating the host simulator (timingTrace.h, tools/traceFit.cpp)
+// #define TIMING_TRACE
 
-#define ONE_TURN 3200
+// Uncomment to reset on a hung loop (WDTO_* timeout from avr/wdt.h). A reset
+// with the axes at rest resumes without homing (warmStart.h)
+// #define WATCHDOG WDTO_2S
 
-// Your scaling constants
-#define Y_SCALE 0.489048
-#define X_SCALE 2.5358
-#define Y_MOVE  107.8
-#define X_MOVE  539.1
+// Serial remote UI: mirror the LCD and accept virtual encoder/button input
+// (protocol in remoteUi.h, PC client in tools/remoteTerm.cpp)
+#define REMOTE_UI       1
+#define REMOTE_CLICK_MS 80    // virtual press length for a remote click
+
+// Background work (background.h): LCD rows written during motion and the
+// remote UI only run when they fit before the next step is due
+#define BG_MARGIN_US 40   // kept free before a step (dispatch + micros() overhead)
+#define BG_LCD_CHUNK 4    // staged LCD characters per transfer (max 6)
+
+#define LIMIT_Y 10
+#define LIMIT_X 9
 
 // Jog step in motor steps per encoder detent
 #define JOG_STEP_X 10
 #define JOG_STEP_Y 10
-
-// Auto grid size (you used 3 x 6 in the test)
-#define AUTO_NUM_X 3   // normally 16
-#define AUTO_NUM_Y 6   // normally 11
+#define GRID_SNAP_TOL 3   // grid jog: distance from a node that counts as on it (steps)
+
+// Step-and-repeat teaching (main menu > Teach Pattern)
+#define TEACH_MAX_COUNT 50   // largest repeat count along X or Y
+
+// 1 = one gesture per auto point (click = Continue, hold = Back/Exit menu)
+// 0 = always show the 3-line Continue/Back/Exit menu
+#define AUTO_FAST_DECISION 1
+
+// Stitch run: probe stays down and each Y column is welded on the fly,
+// firing WELD_TRIGGER_PIN as Y crosses every row position. The pass starts
+// STITCH_RAMP + STITCH_LEAD_IN before the first row and stops STITCH_RAMP +
+// STITCH_OVERTRAVEL after the last, so every row is crossed at STITCH_SPEED.
+#define STITCH_SPEED      800   // Y cruise speed during a stitch pass (steps/s)
+#define STITCH_ACCEL      2000  // Y acceleration of the pass (steps/s^2)
+#define STITCH_LEAD_IN    100   // constant-speed steps before the first row
+#define STITCH_OVERTRAVEL 50    // constant-speed steps after the last row
+#define STITCH_RAMP ((long)((float)STITCH_SPEED * STITCH_SPEED / (2.0 * STITCH_ACCEL)) + 1)
+#define TRIGGER_PULSE_US  2000  // weld trigger pulse width
+
+// Coordinated XY paths (pathPlanner); arc chord limits: motionConfig.h
+#define PATH_QUEUE_LEN   4       // queued line/arc primitives
+#define PATH_ACCEL       500.0   // path acceleration and deceleration (steps/s^2)
+#define PATH_START_SPEED 100.0   // path speed runs start and stop at (steps/s)
+#define PATH_UPDATE_US   2000    // path speed ramp update interval
+#define ARC_FEED         1000.0  // path speed of job arcs (steps/s)
+
+// Keep-out zones {xMin, yMin, xMax, yMax} in machine steps (clamps etc.).
+// Auto-mode travel that would cross one is routed around its corners on the
+// path planner at the travel limits, slowing into each corner (keep
+// PATH_ACCEL at most X_ACCEL / Y_ACCEL); straight travel keeps both axes on
+// its line.
+// #define KEEPOUT_ZONES { { -1400, 150, -1100, 400 } }
+#define KEEPOUT_MARGIN 20      // clearance added around every zone (steps)
+
+// Reachable machine envelope (machine steps, switches at 0). Detour corners
+// outside it are never used; the default covers a 16 x 11 grid.
+#define ENVELOPE_X_MIN -8500
+#define ENVELOPE_X_MAX 0
+#define ENVELOPE_Y_MIN 0
+#define ENVELOPE_Y_MAX 1500
+
+// EEPROM layout: 0..31 machine settings, then the correction map, then the
+// job library up to the end of EEPROM
+#define ORIGIN_EEPROM_BASE 0  // work origin, 9 bytes (workOrigin.h)
+#define CORR_EEPROM_BASE 32   // position correction table (correctionMap.h)
+#define CORR_PROBE_ANGLE 125  // probe hover angle while measuring the table
+
+// Job library (jobLibrary.h): named point lists in EEPROM, run from the auto menu.
+// An empty library is seeded with the compile-time grid as job "GRID".
+#define JOB_EEPROM_BASE 96
 
 // ---------------- Global hardware ----------------
 
 // Defined in main.ino
-extern AccelStepper motorX1;
-extern AccelStepper motorX2;
-extern AccelStepper motorY;
-extern Encoder      myEnc;
-extern LiquidCrystal_I2C lcd;
-extern Servo        servo;
+extern AccelStepper   motorX1;
+extern AccelStepper   motorX2;
+extern TriggerStepper motorY;
+extern Encoder        myEnc;
+extern PackedLcd      lcd;
+extern Servo          servo;
+extern ServoProfile   probe;
+#ifdef HEAD2_PIN
+extern Servo          servo2;
+extern ServoProfile   probe2;
+#endif
 
 // ---------------- FSM types ----------------
 
@@ -63,10 +185,13 @@ enum MachineState {
     STATE_MAIN_MENU = 0,
     STATE_AUTO_MENU,
     STATE_AUTO_RUN,
+    STATE_JOB_MENU,
     STATE_MANUAL_MENU,
     STATE_JOG_X,
     STATE_JOG_Y,
-    STATE_JOG_Z
+    STATE_JOG_Z,
+    STATE_CALIBRATE,
+    STATE_TEACH
 };
 
 // ---------------- Public API ----------------
@@ -77,6 +202,12 @@ enum MachineState {
  */
 void autoHome();
 
+/**
+ * @brief Nominal position of point idx of the compile-time grid, in run
+ * order (column by column, idx = column * AUTO_NUM_Y + row).
+ */
+void autoGridPoint(uint16_t idx, long& x, long& y);
+
 /**
  * @brief Initialize FSM state and first screen.
  */
@@ -86,3 +217,12 @@ void fsmInit();
  * @brief One iteration of the FSM. Call from loop().
  */
 void fsmUpdate();
+
+#ifdef LCD_BENCHMARK
+/**
+ * @brief Times full-row writes with the packed backend and with
+ * LiquidCrystal_I2C (old lcdPrintLine sequence) and prints us/line to Serial.
+ * Blocking; call from setup() after lcd.init() and Serial.begin().
+ */
+void lcdBenchmark();
+#endif
@@ -3,10 +3,15 @@
 // Global hardware objects
 AccelStepper motorX1(AccelStepper::DRIVER, MOTOR_X1_STEP_PIN, MOTOR_X1_DIR_PIN);
 AccelStepper motorX2(AccelStepper::DRIVER, MOTOR_X2_STEP_PIN, MOTOR_X2_DIR_PIN);
-AccelStepper motorY (AccelStepper::DRIVER, MOTOR_Y_STEP_PIN,  MOTOR_Y_DIR_PIN);
+TriggerStepper motorY(AccelStepper::DRIVER, MOTOR_Y_STEP_PIN,  MOTOR_Y_DIR_PIN);
 Encoder       myEnc(ENC_CCW, ENC_CW);
-LiquidCrystal_I2C lcd(I2C_ADDRESS, LCD_COLUMNS, LCD_ROWS);
+PackedLcd     lcd(I2C_ADDRESS, LCD_COLUMNS, LCD_ROWS);
 Servo         servo;
+ServoProfile  probe(SERVO_MAX_VEL, SERVO_ACCEL);
+#ifdef HEAD2_PIN
+Servo         servo2;
+ServoProfile  probe2(SERVO_MAX_VEL, SERVO_ACCEL);
+#endif
 
 void setup() {
     lcd.init();
@@ -16,35 +21,60 @@ void setup() {
 
     pinMode(ENABLE_PIN, OUTPUT);
     digitalWrite(ENABLE_PIN, LOW);  // enable steppers
+#ifdef MICROSTEP_PIN
+    pinMode(MICROSTEP_PIN, OUTPUT);
+    digitalWrite(MICROSTEP_PIN, HIGH);  // fine (1/16) steps
+#endif
 
-    motorX1.setAcceleration(500);
-    motorX1.setMaxSpeed(8000);
-    motorX2.setAcceleration(500);
-    motorX2.setMaxSpeed(8000);
-    motorY.setAcceleration(500);
-    motorY.setMaxSpeed(10000);
+    motorX1.setAcceleration(X_ACCEL);
+    motorX1.setMaxSpeed(X_MAX_SPEED);
+    motorX2.setAcceleration(X_ACCEL);
+    motorX2.setMaxSpeed(X_MAX_SPEED);
+    motorY.setAcceleration(Y_ACCEL);
+    motorY.setMaxSpeed(Y_MAX_SPEED);
 
     pinMode(LIMIT_X, INPUT_PULLUP);
     pinMode(LIMIT_Y, INPUT_PULLUP);
 
-    servo.attach(11);
-    servo.write(90);
+    pinMode(WELD_TRIGGER_PIN, OUTPUT);
+    digitalWrite(WELD_TRIGGER_PIN, LOW);
+
+    servo.attach(SERVO_PIN);
+    probe.begin(servo, PROBE_UP_ANGLE);
+#ifdef HEAD2_PIN
+    servo2.attach(HEAD2_PIN);
+    probe2.begin(servo2, PROBE_UP_ANGLE);
+#endif
 
     Serial.begin(115200);
 
+#ifdef LCD_BENCHMARK
+    lcdBenchmark();
+#endif
+
     lcd.noCursor();
     lcd.clear();
     lcd.setCursor(0, 0);
-    lcd.print("Push Button To Begin");
 
-    // Wait for initial button press
-    while (digitalRead(BUTTON_PIN) == HIGH) { /* idle */ }
-    delay(200); // crude debounce
+    // Warm restart (watchdog / reset button, axes were at rest): positions
+    // are still valid, so skip the prompt and homing
+    if (warmRestore()) {
+        lcd.print("Warm restart");
+    } else {
+        lcd.print("Push Button To Begin");
+
+        // Wait for initial button press
+        while (digitalRead(BUTTON_PIN) == HIGH && !remoteButtonDown()) {
+            remoteUiService(); // mirror the prompt and accept a remote start
+            warmKick();
+        }
+        delay(200); // crude debounce
 
-    // Home once at startup
-    autoHome();
+        // Home once at startup
+        autoHome();
+    }
 
-    // Initialize FSM (main menu, etc.)
+    // Initialize FSM (main menu, or the interrupted auto run)
     fsmInit();
 }
 
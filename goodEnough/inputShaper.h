@@ -0,0 +1,70 @@
+#pragma once
+
+// ZV / ZVD input shapers (no Arduino dependencies, shared with host tools).
+
+#include <math.h>
+#include "profile.h"
+
+#define SHAPER_NONE 0
+#define SHAPER_ZV   1   // 2 impulses, duration Td/2, sensitive to frequency error
+#define SHAPER_ZVD  2   // 3 impulses, duration Td, more robust to frequency error
+
+/**
+ * @brief Impulse sequence that cancels one lightly damped resonance.
+ *
+ * The commanded motion is the sum of delayed, scaled copies of the unshaped
+ * motion: x_shaped(t) = sum_i amp[i] * x(t - time[i]). Amplitudes sum to 1,
+ * so the end position is unchanged; the move gets longer by duration().
+ */
+struct InputShaper {
+    uint8_t count;   ///< number of impulses (1 = pass-through)
+    float   amp[3];
+    float   time[3]; ///< seconds
+
+    float duration() const { return time[count - 1]; }
+};
+
+/**
+ * @brief Designs a shaper for a resonance at freqHz with damping ratio zeta.
+ * SHAPER_NONE (or freqHz <= 0) gives a single unit impulse.
+ */
+inline InputShaper shaperDesign(uint8_t type, float freqHz, float zeta) {
+    InputShaper s;
+    s.count   = 1;
+    s.amp[0]  = 1;
+    s.time[0] = 0;
+    if (type == SHAPER_NONE || freqHz <= 0) {
+        return s;
+    }
+
+    float wd = sqrt(1 - zeta * zeta);
+    float K  = exp(-zeta * M_PI / wd);
+    float Td = 1.0f / (freqHz * wd);  // damped period
+
+    if (type == SHAPER_ZV) {
+        s.count   = 2;
+        s.amp[0]  = 1 / (1 + K);
+        s.amp[1]  = K / (1 + K);
+        s.time[1] = 0.5f * Td;
+    } else {
+        float d   = (1 + K) * (1 + K);
+        s.count   = 3;
+        s.amp[0]  = 1 / d;
+        s.amp[1]  = 2 * K / d;
+        s.amp[2]  = K * K / d;
+        s.time[1] = 0.5f * Td;
+        s.time[2] = Td;
+    }
+    return s;
+}
+
+/**
+ * @brief Shaped distance along a trapezoidal move at time t.
+ */
+inline float shapedPosition(const TrapezoidProfile& p, const InputShaper& s, float t) {
+    float x = 0;
+    for (uint8_t i = 0; i < s.count; i++) {
+        x += s.amp[i] * profilePosition(p, t - s.time[i]);
+    }
+    return x;
+}
@@ -0,0 +1,340 @@
+#include "functions.h"
+
+/*
+  Job library in EEPROM (format in jobLibrary.h).
+
+  All writes go through EEPROM.update() so unchanged bytes are not worn.
+  Directory entries are kept dense and in data order: the data of job i is
+  followed by the data of job i + 1, so a new job is appended after the last
+  one and deleting a job slides everything behind it down.
+*/
+
+#define JOB_HEADER_ADDR  (JOB_EEPROM_BASE)
+#define JOB_RECIPE_ADDR  (JOB_HEADER_ADDR + 4)
+#define JOB_DIR_ADDR     (JOB_RECIPE_ADDR + JOB_MAX_RECIPES * sizeof(JobRecipe))
+#define JOB_DATA_ADDR    (JOB_DIR_ADDR + JOB_MAX_JOBS * sizeof(JobEntry))
+
+// Job being written (jobBegin() .. jobEnd())
+static bool     gWriteOpen     = false;
+static bool     gWriteOverflow = false;
+static char     gWriteName[JOB_NAME_LEN];
+static uint16_t gWriteStart    = 0;
+static uint16_t gWriteAddr     = 0;
+static uint16_t gWritePoints   = 0;
+static uint8_t  gWriteRecipe   = 0;
+static uint8_t  gWriteFirst    = 0;
+static long     gWriteX        = 0;
+static long     gWriteY        = 0;
+
+// --------------- Low-level helpers ---------------
+
+static uint16_t dataEnd() {
+    return EEPROM.length();
+}
+
+static uint16_t dirAddr(uint8_t idx) {
+    return JOB_DIR_ADDR + idx * sizeof(JobEntry);
+}
+
+static void setCount(uint8_t n) {
+    EEPROM.update(JOB_HEADER_ADDR + 3, n);
+}
+
+// First free data byte (after the last job)
+static uint16_t dataTail() {
+    uint8_t n = jobCount();
+    if (n == 0) {
+        return JOB_DATA_ADDR;
+    }
+    JobEntry e;
+    EEPROM.get(dirAddr(n - 1), e);
+    return e.offset + e.length;
+}
+
+static void copyName(char* dst, const char* src) {
+    for (uint8_t i = 0; i < JOB_NAME_LEN; i++) {
+        dst[i] = (*src != '\0') ? *src++ : ' ';
+    }
+}
+
+static uint32_t zigzag(long v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static long unzigzag(uint32_t v) {
+    return (long)(v >> 1) ^ -(long)(v & 1);
+}
+
+static void putByte(uint8_t b) {
+    if (gWriteAddr >= dataEnd()) {
+        gWriteOverflow = true;
+        return;
+    }
+    EEPROM.update(gWriteAddr++, b);
+}
+
+static void putVarint(uint32_t v) {
+    while (v >= 0x80) {
+        putByte((uint8_t)(v & 0x7f) | 0x80);
+        v >>= 7;
+    }
+    putByte((uint8_t)v);
+}
+
+static uint32_t getVarint(uint16_t& addr) {
+    uint32_t v = 0;
+    uint8_t  shift = 0;
+    uint8_t  b;
+    do {
+        b = EEPROM.read(addr++);
+        v |= (uint32_t)(b & 0x7f) << shift;
+        shift += 7;
+    } while ((b & 0x80) && shift < 35);
+    return v;
+}
+
+// --------------- Library / directory ---------------
+
+/*
+  jobLibraryInit():
+  A blank or foreign EEPROM gets default recipes (current probe settings,
+  operator confirmation at every point) and an empty directory.
+*/
+bool jobLibraryInit() {
+    if (EEPROM.read(JOB_HEADER_ADDR) == 'J' && EEPROM.read(JOB_HEADER_ADDR + 1) == 'L' &&
+        EEPROM.read(JOB_HEADER_ADDR + 2) == JOB_LIB_VERSION &&
+        EEPROM.read(JOB_HEADER_ADDR + 3) <= JOB_MAX_JOBS) {
+        return true;
+    }
+
+    JobRecipe r;
+    r.probeDown = PROBE_DOWN_ANGLE;
+    r.settleMs  = PROBE_SETTLE_MS;
+    r.dwellMs   = 0;
+    for (uint8_t i = 0; i < JOB_MAX_RECIPES; i++) {
+        jobSetRecipe(i, r);
+    }
+
+    EEPROM.update(JOB_HEADER_ADDR,     'J');
+    EEPROM.update(JOB_HEADER_ADDR + 1, 'L');
+    EEPROM.update(JOB_HEADER_ADDR + 2, JOB_LIB_VERSION);
+    jobLibraryFormat();
+    return false;
+}
+
+void jobLibraryFormat() {
+    setCount(0);
+    gWriteOpen = false;
+}
+
+uint8_t jobCount() {
+    return EEPROM.read(JOB_HEADER_ADDR + 3);
+}
+
+bool jobEntry(uint8_t idx, JobEntry& e) {
+    if (idx >= jobCount()) {
+        return false;
+    }
+    EEPROM.get(dirAddr(idx), e);
+    return true;
+}
+
+uint8_t jobFind(const char* name) {
+    char key[JOB_NAME_LEN];
+    copyName(key, name);
+
+    JobEntry e;
+    for (uint8_t i = 0; jobEntry(i, e); i++) {
+        if (memcmp(e.name, key, JOB_NAME_LEN) == 0) {
+            return i;
+        }
+    }
+    return JOB_NONE;
+}
+
+/*
+  jobDelete():
+  Slides the data of every later job down over the deleted one and shifts
+  their directory entries up one slot.
+*/
+bool jobDelete(uint8_t idx) {
+    JobEntry gone;
+    if (!jobEntry(idx, gone)) {
+        return false;
+    }
+
+    uint16_t tail = dataTail();
+    for (uint16_t a = gone.offset + gone.length; a < tail; a++) {
+        EEPROM.update(a - gone.length, EEPROM.read(a));
+    }
+
+    uint8_t n = jobCount();
+    for (uint8_t i = idx + 1; i < n; i++) {
+        JobEntry e;
+        EEPROM.get(dirAddr(i), e);
+        e.offset -= gone.length;
+        EEPROM.put(dirAddr(i - 1), e);
+    }
+    setCount(n - 1);
+    return true;
+}
+
+uint16_t jobFreeBytes() {
+    return dataEnd() - dataTail();
+}
+
+bool jobGetRecipe(uint8_t idx, JobRecipe& r) {
+    if (idx >= JOB_MAX_RECIPES) {
+        return false;
+    }
+    EEPROM.get(JOB_RECIPE_ADDR + idx * sizeof(JobRecipe), r);
+    return true;
+}
+
+bool jobSetRecipe(uint8_t idx, const JobRecipe& r) {
+    if (idx >= JOB_MAX_RECIPES) {
+        return false;
+    }
+    EEPROM.put(JOB_RECIPE_ADDR + idx * sizeof(JobRecipe), r);
+    return true;
+}
+
+// --------------- Writing ---------------
+
+// A full directory has no slot for the new copy, so there the old job goes first
+bool jobBegin(const char* name, uint8_t recipe) {
+    if (jobCount() >= JOB_MAX_JOBS) {
+        uint8_t old = jobFind(name);
+        if (old == JOB_NONE) {
+            return false;
+        }
+        jobDelete(old);
+    }
+    copyName(gWriteName, name);
+    gWriteStart    = dataTail();
+    gWriteAddr     = gWriteStart;
+    gWritePoints   = 0;
+    gWriteRecipe   = recipe < JOB_MAX_RECIPES ? recipe : 0;
+    gWriteFirst    = gWriteRecipe;
+    gWriteX        = 0;
+    gWriteY        = 0;
+    gWriteOverflow = false;
+    gWriteOpen     = true;
+    return true;
+}
+
+// One point record; the arc center is stored relative to the previous point
+static bool addRecord(long x, long y, bool arc, long cx, long cy, bool ccw, uint8_t recipe) {
+    if (!gWriteOpen || gWriteOverflow || gWritePoints == 0xffff) {
+        return false;
+    }
+    bool change = (recipe < JOB_MAX_RECIPES && recipe != gWriteRecipe);
+
+    putVarint((zigzag(x - gWriteX) << 2) | (arc ? 2 : 0) | (change ? 1 : 0));
+    putVarint(zigzag(y - gWriteY));
+    if (arc) {
+        putVarint((zigzag(cx - gWriteX) << 1) | (ccw ? 1 : 0));
+        putVarint(zigzag(cy - gWriteY));
+    }
+    if (change) {
+        putByte(recipe);
+        gWriteRecipe = recipe;
+    }
+
+    gWriteX = x;
+    gWriteY = y;
+    gWritePoints++;
+    return !gWriteOverflow;
+}
+
+bool jobAddPoint(long x, long y, uint8_t recipe) {
+    return addRecord(x, y, false, 0, 0, false, recipe);
+}
+
+bool jobAddArc(long x, long y, long cx, long cy, bool ccw, uint8_t recipe) {
+    return addRecord(x, y, true, cx, cy, ccw, recipe);
+}
+
+/*
+  jobEnd():
+  The new job is committed before an older job of the same name is deleted,
+  so a failed rewrite never loses the old copy (unless the directory was
+  full, see jobBegin()). Replacing a job therefore needs room for both
+  copies for a moment.
+*/
+uint8_t jobEnd() {
+    if (!gWriteOpen) {
+        return JOB_NONE;
+    }
+    gWriteOpen = false;
+
+    uint8_t old = jobFind(gWriteName);
+    uint8_t n   = jobCount();
+    if (gWriteOverflow || gWritePoints == 0 || n >= JOB_MAX_JOBS) {
+        return JOB_NONE;
+    }
+
+    JobEntry e;
+    memcpy(e.name, gWriteName, JOB_NAME_LEN);
+    e.offset = gWriteStart;
+    e.length = gWriteAddr - gWriteStart;
+    e.points = gWritePoints;
+    e.recipe = gWriteFirst;
+    EEPROM.put(dirAddr(n), e);
+    setCount(n + 1);
+
+    if (old != JOB_NONE) {
+        jobDelete(old);
+        return n - 1;
+    }
+    return n;
+}
+
+// --------------- Reading ---------------
+
+bool jobOpen(uint8_t idx, JobReader& rd) {
+    JobEntry e;
+    if (!jobEntry(idx, e)) {
+        return false;
+    }
+    rd.addr   = e.offset;
+    rd.left   = e.points;
+    rd.x      = 0;
+    rd.y      = 0;
+    rd.recipe = e.recipe;
+    rd.arc    = false;
+    return true;
+}
+
+bool jobNext(JobReader& rd) {
+    if (rd.left == 0) {
+        return false;
+    }
+    uint32_t first = getVarint(rd.addr);
+    rd.sx  = rd.x;
+    rd.sy  = rd.y;
+    rd.x  += unzigzag(first >> 2);
+    rd.y  += unzigzag(getVarint(rd.addr));
+    rd.arc = (first & 2) != 0;
+    if (rd.arc) {
+        uint32_t c = getVarint(rd.addr);
+        rd.ccw = (c & 1) != 0;
+        rd.cx  = rd.sx + unzigzag(c >> 1);
+        rd.cy  = rd.sy + unzigzag(getVarint(rd.addr));
+    }
+    if (first & 1) {
+        rd.recipe = EEPROM.read(rd.addr++);
+    }
+    rd.left--;
+    return true;
+}
+
+bool jobSeek(uint8_t idx, uint16_t n, JobReader& rd) {
+    if (!jobOpen(idx, rd) || n >= rd.left) {
+        return false;
+    }
+    for (uint16_t i = 0; i <= n; i++) {
+        jobNext(rd);
+    }
+    return true;
+}
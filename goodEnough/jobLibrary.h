@@ -0,0 +1,159 @@
+#pragma once
+
+#include <Arduino.h>
+#include <EEPROM.h>
+
+/**
+ * @brief Library of named weld jobs stored compactly in EEPROM.
+ *
+ * Layout (from JOB_EEPROM_BASE):
+ *   header     'J' 'L' version jobCount
+ *   recipes    JOB_MAX_RECIPES x JobRecipe, shared by all jobs
+ *   directory  JOB_MAX_JOBS x JobEntry (name, data offset/length, points, recipe)
+ *   data       point streams of all jobs, packed back to back
+ *
+ * A point stream stores every point as the delta to the previous one
+ * (the first point is relative to 0,0):
+ *   varint  (zigzag(dx) << 2) | (arc << 1) | recipeFollows
+ *   varint  zigzag(dy)
+ *   [varint (zigzag(cx - px) << 1) | ccw]   only if arc
+ *   [varint zigzag(cy - py)]               only if arc
+ *   [u8     recipe index]    only if recipeFollows
+ * An arc point is reached on a circular arc around (cx, cy) from the point
+ * before it, (px, py), instead of a straight move.
+ * Varints are 7 bits per byte, low group first, high bit = more bytes.
+ * A grid hop of a few hundred steps costs 2 bytes per axis instead of the
+ * 4 of a raw long, and repeated recipes cost nothing.
+ *
+ * Jobs are written once (jobBegin(), jobAddPoint()..., jobEnd()) and read
+ * back with a JobReader that holds only the running position, so a job of
+ * any length is replayed point by point with a few bytes of RAM.
+ */
+
+#define JOB_LIB_VERSION 2
+#define JOB_NAME_LEN    8     // job name, space padded (not NUL-terminated)
+#define JOB_MAX_JOBS    8
+#define JOB_MAX_RECIPES 4
+#define JOB_NONE        0xff
+
+/**
+ * @brief Process parameters shared by any number of jobs / points.
+ */
+struct JobRecipe {
+    uint8_t  probeDown; // probe down angle (deg)
+    uint8_t  settleMs;  // dwell after the probe move before continuing
+    uint16_t dwellMs;   // 0 = wait for the operator at each point, else auto-continue after this
+};
+
+/**
+ * @brief Directory entry of one stored job.
+ */
+struct JobEntry {
+    char     name[JOB_NAME_LEN];
+    uint16_t offset;    // first data byte (EEPROM address)
+    uint16_t length;    // data bytes
+    uint16_t points;
+    uint8_t  recipe;    // recipe of the first point
+};
+
+/**
+ * @brief Streaming decoder state for one job (O(1) RAM).
+ */
+struct JobReader {
+    uint16_t addr;      // next data byte
+    uint16_t left;      // points not yet read
+    long     x;         // last decoded point
+    long     y;
+    uint8_t  recipe;    // recipe in effect for the last point
+    bool     arc;       // last point is reached on an arc from (sx, sy)
+    bool     ccw;       // arc direction (G3 if true, else G2)
+    long     sx;        // arc start: the point before
+    long     sy;
+    long     cx;        // arc center
+    long     cy;
+};
+
+/**
+ * @brief Checks the header; formats an empty library if it is missing or
+ * from another version.
+ * @return true if an existing library was found.
+ */
+bool jobLibraryInit();
+
+/**
+ * @brief Erases all jobs (recipes are kept).
+ */
+void jobLibraryFormat();
+
+uint8_t jobCount();
+
+/**
+ * @brief Directory entry of job idx (0..jobCount()-1).
+ */
+bool jobEntry(uint8_t idx, JobEntry& e);
+
+/**
+ * @brief Index of the job with this name, or JOB_NONE.
+ */
+uint8_t jobFind(const char* name);
+
+/**
+ * @brief Deletes a job and compacts the data area.
+ */
+bool jobDelete(uint8_t idx);
+
+/**
+ * @brief Data bytes still free for new jobs.
+ */
+uint16_t jobFreeBytes();
+
+bool jobGetRecipe(uint8_t idx, JobRecipe& r);
+bool jobSetRecipe(uint8_t idx, const JobRecipe& r);
+
+// ---------------- Writing ----------------
+
+/**
+ * @brief Starts appending a new job (replaces an existing job of the same name
+ * when jobEnd() commits). Only one job can be open at a time.
+ * @return false if the directory is full.
+ */
+bool jobBegin(const char* name, uint8_t recipe);
+
+/**
+ * @brief Appends a point; recipe JOB_NONE keeps the current one.
+ * @return false if the data area is full (the job is then discarded by jobEnd()).
+ */
+bool jobAddPoint(long x, long y, uint8_t recipe = JOB_NONE);
+
+/**
+ * @brief Appends a point reached on an arc around (cx, cy) from the
+ * previous point (see pathArc()); recipe JOB_NONE keeps the current one.
+ * @return false if the data area is full (the job is then discarded by jobEnd()).
+ */
+bool jobAddArc(long x, long y, long cx, long cy, bool ccw, uint8_t recipe = JOB_NONE);
+
+/**
+ * @brief Commits the open job to the directory.
+ * @return Index of the new job, or JOB_NONE if it was empty or overflowed.
+ */
+uint8_t jobEnd();
+
+// ---------------- Reading ----------------
+
+/**
+ * @brief Positions a reader at the first point of job idx.
+ */
+bool jobOpen(uint8_t idx, JobReader& rd);
+
+/**
+ * @brief Decodes the next point into rd.x / rd.y / rd.recipe (and the arc
+ * fields for an arc point).
+ * @return false once all points have been read.
+ */
+bool jobNext(JobReader& rd);
+
+/**
+ * @brief Re-opens job idx and decodes up to point n (0-based), for stepping
+ * back. Costs O(n) time, still O(1) RAM.
+ */
+bool jobSeek(uint8_t idx, uint16_t n, JobReader& rd);
@@ -0,0 +1,284 @@
+#include "functions.h"
+
+/*
+  Keep-out zones and travel routing.
+
+  Zones come from KEEPOUT_ZONES in functions.h. Each zone is grown by
+  KEEPOUT_MARGIN for collision tests; detour waypoints sit one step further
+  out, so a route that runs along a zone edge never counts as entering it.
+
+  Routing is a plain Dijkstra over start, goal and the outer corners of every
+  zone (at most 2 + 4 * KEEPOUT_COUNT nodes), with an edge wherever the
+  straight segment is clear. With the handful of clamps on a fixture this is
+  a few hundred segment tests, done once per planned move. Corners outside
+  the machine envelope (ENVELOPE_*) are not used.
+
+  Legs run on the path planner as straight lines, fed in as the queue has
+  room, so the gantry blends through the corners: the planner ramps at
+  PATH_ACCEL and slows into every corner to its junction speed
+  (profile.h), which bounds the speed change of each axis there. Each leg's
+  feed is the highest path speed that keeps both axes within their travel
+  limits, and PATH_ACCEL is no more than X_ACCEL / Y_ACCEL, so no axis
+  exceeds its own limits either. Every leg is the straight segment the
+  collision test checked.
+*/
+
+#ifdef KEEPOUT_ZONES
+static const KeepOutZone kZones[] = KEEPOUT_ZONES;
+#define KEEPOUT_COUNT (sizeof(kZones) / sizeof(kZones[0]))
+#define KEEPOUT_NODES (2 + 4 * KEEPOUT_COUNT)
+#define KEEPOUT_MAX_LEGS (KEEPOUT_NODES - 1)
+#else
+#define KEEPOUT_MAX_LEGS 1
+#endif
+
+// Route being run: waypoints after the start, goal last; gRouteNext is the
+// next one to queue, from (gLegX, gLegY)
+static long    gRouteX[KEEPOUT_MAX_LEGS];
+static long    gRouteY[KEEPOUT_MAX_LEGS];
+static uint8_t gRouteCount = 0;
+static uint8_t gRouteNext  = 0;
+static long    gLegX       = 0;
+static long    gLegY       = 0;
+
+#ifdef KEEPOUT_ZONES
+
+/*
+  segmentHitsZone():
+  Liang-Barsky clip against the OPEN rectangle grown by the margin.
+  Touching or sliding along the boundary is allowed; only a segment that
+  spends a non-zero length strictly inside counts as a hit.
+*/
+static bool segmentHitsZone(const KeepOutZone& z, long x0, long y0, long x1, long y1) {
+    float lo[2] = { (float)(z.xMin - KEEPOUT_MARGIN), (float)(z.yMin - KEEPOUT_MARGIN) };
+    float hi[2] = { (float)(z.xMax + KEEPOUT_MARGIN), (float)(z.yMax + KEEPOUT_MARGIN) };
+    float p0[2] = { (float)x0, (float)y0 };
+    float d[2]  = { (float)(x1 - x0), (float)(y1 - y0) };
+
+    float tEnter = 0;
+    float tExit  = 1;
+    for (uint8_t axis = 0; axis < 2; axis++) {
+        if (d[axis] == 0) {
+            if (p0[axis] <= lo[axis] || p0[axis] >= hi[axis]) {
+                return false; // parallel and outside (or on) this slab
+            }
+            continue;
+        }
+        float ta = (lo[axis] - p0[axis]) / d[axis];
+        float tb = (hi[axis] - p0[axis]) / d[axis];
+        if (ta > tb) { float t = ta; ta = tb; tb = t; }
+        if (ta > tEnter) tEnter = ta;
+        if (tb < tExit)  tExit  = tb;
+        if (tEnter >= tExit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Corner c (0..3) of zone z, one step outside the grown rectangle
+static void zoneCorner(uint8_t z, uint8_t c, long& x, long& y) {
+    long m = KEEPOUT_MARGIN + 1;
+    x = (c & 1) ? kZones[z].xMax + m : kZones[z].xMin - m;
+    y = (c & 2) ? kZones[z].yMax + m : kZones[z].yMin - m;
+}
+
+bool keepOutInside(long x, long y) {
+    for (uint8_t z = 0; z < KEEPOUT_COUNT; z++) {
+        if (x > kZones[z].xMin - KEEPOUT_MARGIN && x < kZones[z].xMax + KEEPOUT_MARGIN &&
+            y > kZones[z].yMin - KEEPOUT_MARGIN && y < kZones[z].yMax + KEEPOUT_MARGIN) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool keepOutBlocked(long x0, long y0, long x1, long y1) {
+    for (uint8_t z = 0; z < KEEPOUT_COUNT; z++) {
+        if (segmentHitsZone(kZones[z], x0, y0, x1, y1)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+  keepOutArcBlocked():
+  Tests the arc as chords that stay within half the margin of it, so a
+  clear chord keeps the arc (and the ARC_TOLERANCE chords the planner runs)
+  clear of every zone.
+*/
+bool keepOutArcBlocked(long x0, long y0, long x1, long y1, long cx, long cy, bool ccw) {
+    ArcGen g;
+    arcBegin(g, x0, y0, x1, y1, cx, cy, ccw, KEEPOUT_MARGIN / 2.0f, ARC_CORRECTION);
+
+    long px = x0;
+    long py = y0;
+    while (g.active) {
+        long x, y;
+        arcNext(g, x, y);
+        if (keepOutBlocked(px, py, x, y)) {
+            return true;
+        }
+        px = x;
+        py = y;
+    }
+    return false;
+}
+
+// Detour corners must be reachable: inside the envelope and no other zone
+static bool cornerUsable(long x, long y) {
+    return x >= ENVELOPE_X_MIN && x <= ENVELOPE_X_MAX &&
+           y >= ENVELOPE_Y_MIN && y <= ENVELOPE_Y_MAX && !keepOutInside(x, y);
+}
+
+bool keepOutRoute(long x, long y) {
+    long sx = motorX1.currentPosition();
+    long sy = motorY.currentPosition();
+
+    if (gRouteCount != 0 || keepOutInside(x, y)) {
+        return false;
+    }
+    gLegX = sx;
+    gLegY = sy;
+    if (!keepOutBlocked(sx, sy, x, y)) {
+        gRouteX[0]  = x;
+        gRouteY[0]  = y;
+        gRouteCount = 1;
+        gRouteNext  = 0;
+        return true;
+    }
+
+    // Node table: 0 = start, 1 = goal, 2.. = zone corners
+    long  nx[KEEPOUT_NODES];
+    long  ny[KEEPOUT_NODES];
+    bool  usable[KEEPOUT_NODES];
+    float dist[KEEPOUT_NODES];
+    int8_t prev[KEEPOUT_NODES];
+    bool  done[KEEPOUT_NODES];
+
+    nx[0] = sx; ny[0] = sy;
+    nx[1] = x;  ny[1] = y;
+    for (uint8_t z = 0; z < KEEPOUT_COUNT; z++) {
+        for (uint8_t c = 0; c < 4; c++) {
+            zoneCorner(z, c, nx[2 + 4 * z + c], ny[2 + 4 * z + c]);
+        }
+    }
+    for (uint8_t i = 0; i < KEEPOUT_NODES; i++) {
+        usable[i] = (i < 2) || cornerUsable(nx[i], ny[i]);
+        dist[i]   = 1e30;
+        prev[i]   = -1;
+        done[i]   = false;
+    }
+    dist[0] = 0;
+
+    for (;;) {
+        int8_t u = -1;
+        for (uint8_t i = 0; i < KEEPOUT_NODES; i++) {
+            if (usable[i] && !done[i] && (u < 0 || dist[i] < dist[u])) {
+                u = i;
+            }
+        }
+        if (u < 0 || dist[u] >= 1e30) {
+            return false;           // goal unreachable
+        }
+        if (u == 1) {
+            break;
+        }
+        done[u] = true;
+
+        for (uint8_t v = 0; v < KEEPOUT_NODES; v++) {
+            if (!usable[v] || done[v] || keepOutBlocked(nx[u], ny[u], nx[v], ny[v])) {
+                continue;
+            }
+            float dx = (float)(nx[v] - nx[u]);
+            float dy = (float)(ny[v] - ny[u]);
+            float d  = dist[u] + sqrt(dx * dx + dy * dy);
+            if (d < dist[v]) {
+                dist[v] = d;
+                prev[v] = u;
+            }
+        }
+    }
+
+    // Walk back from the goal: the route has one leg per node after the start
+    uint8_t count = 0;
+    for (int8_t n = 1; n != 0; n = prev[n]) {
+        count++;
+    }
+    gRouteCount = count;
+    gRouteNext  = 0;
+    for (int8_t n = 1; n != 0; n = prev[n]) {
+        count--;
+        gRouteX[count] = nx[n];
+        gRouteY[count] = ny[n];
+    }
+    return true;
+}
+
+#else  // no zones configured: every move is direct
+
+bool keepOutInside(long, long) {
+    return false;
+}
+
+bool keepOutBlocked(long, long, long, long) {
+    return false;
+}
+
+bool keepOutArcBlocked(long, long, long, long, long, long, bool) {
+    return false;
+}
+
+bool keepOutRoute(long x, long y) {
+    if (gRouteCount != 0) {
+        return false;
+    }
+    gLegX       = motorX1.currentPosition();
+    gLegY       = motorY.currentPosition();
+    gRouteX[0]  = x;
+    gRouteY[0]  = y;
+    gRouteCount = 1;
+    gRouteNext  = 0;
+    return true;
+}
+
+#endif
+
+// Feed of a straight leg: the fastest path speed within both axes' limits
+static float legFeed(long dx, long dy) {
+    float vx = X_MAX_SPEED;
+    float vy = Y_MAX_SPEED;
+    float ax = X_ACCEL;
+    float ay = Y_ACCEL;
+    profileLineLimits((float)dx, (float)dy, vx, vy, ax, ay);
+    if (dx == 0) {
+        return vy;
+    }
+    if (dy == 0) {
+        return vx;
+    }
+    return sqrt(vx * vx + vy * vy);
+}
+
+bool keepOutRun() {
+    if (gRouteCount == 0) {
+        return false;
+    }
+    while (gRouteNext < gRouteCount) {
+        long x = gRouteX[gRouteNext];
+        long y = gRouteY[gRouteNext];
+        if (!pathLine(x, y, legFeed(x - gLegX, y - gLegY))) {
+            break;   // queue full: the rest goes in as legs finish
+        }
+        gLegX = x;
+        gLegY = y;
+        gRouteNext++;
+    }
+    if (pathRun()) {
+        return true;
+    }
+    gRouteCount = 0;
+    gRouteNext  = 0;
+    return false;
+}
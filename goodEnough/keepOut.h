@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Axis-aligned keep-out rectangle in machine steps (e.g. a clamp).
+ */
+struct KeepOutZone {
+    long xMin;
+    long yMin;
+    long xMax;
+    long yMax;
+};
+
+/**
+ * @brief True if (x, y) lies inside a keep-out zone (including KEEPOUT_MARGIN).
+ */
+bool keepOutInside(long x, long y);
+
+/**
+ * @brief True if the straight segment (x0, y0) -> (x1, y1) passes through a
+ * keep-out zone (including KEEPOUT_MARGIN).
+ */
+bool keepOutBlocked(long x0, long y0, long x1, long y1);
+
+/**
+ * @brief True if the arc (x0, y0) -> (x1, y1) around (cx, cy) passes
+ * through a keep-out zone (including KEEPOUT_MARGIN).
+ */
+bool keepOutArcBlocked(long x0, long y0, long x1, long y1, long cx, long cy, bool ccw);
+
+/**
+ * @brief Starts a travel move from the current position to (x, y),
+ * detouring around keep-out zones and staying inside the machine envelope.
+ *
+ * The route is the shortest path over the zone corners (visibility graph).
+ * Its legs run on the path planner as straight lines at the travel limits,
+ * ramped and slowed into each corner to its junction speed rather than
+ * stopped. Drive it with keepOutRun().
+ *
+ * @return false (nothing started) if a route is still running, the target is
+ * inside a zone, or no route exists.
+ */
+bool keepOutRoute(long x, long y);
+
+/**
+ * @brief Advances the route started by keepOutRoute(). Call every loop.
+ * @return true while the route is in progress.
+ */
+bool keepOutRun();
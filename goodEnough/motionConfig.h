@@ -0,0 +1,89 @@
+#pragma once
+
+// Motion and grid constants. Kept free of Arduino includes so the host tools
+// in /tools can build against the same numbers as the firmware.
+
+#define ONE_TURN 3200
+
+// Your scaling constants
+#define Y_SCALE 0.489048
+#define X_SCALE 2.5358
+#define Y_MOVE  107.8
+#define X_MOVE  539.1
+
+// Probe servo (profiled by ServoProfile instead of jumping with servo.write())
+#define PROBE_UP_ANGLE    90
+#define PROBE_DOWN_ANGLE  135   // adjust for your linkage
+#define SERVO_MAX_VEL     600.0   // deg/s, below the servo's own no-load speed
+#define SERVO_ACCEL       9000.0  // deg/s^2; 90->135 then takes ~140 ms
+
+// Auto grid size (you used 3 x 6 in the test)
+#define AUTO_NUM_X 3   // normally 16
+#define AUTO_NUM_Y 6   // normally 11
+
+// Where autoHome() leaves the axes after backing off the switches (steps)
+#define HOME_BACKOFF_X -300
+#define HOME_BACKOFF_Y 250
+
+// Relative X move per auto column (both X motors)
+#define AUTO_X_STEP -500
+
+// Nominal position of grid point idx, column by column (idx = column *
+// AUTO_NUM_Y + row): columns AUTO_X_STEP apart starting one step from the
+// homed position, rows at (row + 1) * Y_MOVE. autoGridPoint() and the host
+// tools share it.
+inline void gridPoint(unsigned int idx, long& x, long& y) {
+    unsigned int col = idx / AUTO_NUM_Y;
+    unsigned int row = idx % AUTO_NUM_Y;
+    x = HOME_BACKOFF_X + (long)(col + 1) * AUTO_X_STEP;
+    y = (long)((row + 1) * Y_MOVE);
+}
+
+// Arc chords (arcGen.h): max deviation from the true arc, including the
+// rounding of chord end points to whole steps, and the exact sin/cos
+// re-anchor interval of the fixed-point rotation
+#define ARC_TOLERANCE  2.0   // steps
+#define ARC_CORRECTION 16    // chords
+
+// Position correction lattice (correctionMap.h): CORR_NX x CORR_NY nodes
+// from (CORR_X0, CORR_Y0) at the given pitch, in machine steps. The default
+// covers the auto grid with its corner and middle points.
+#define CORR_NX      3
+#define CORR_NY      3
+#define CORR_X0      -800
+#define CORR_Y0      108
+#define CORR_PITCH_X -500
+#define CORR_PITCH_Y 269
+
+// Axis limits for normal (long) moves, steps/s and steps/s^2
+#define X_MAX_SPEED 8000
+#define X_ACCEL     500
+#define Y_MAX_SPEED 10000
+#define Y_ACCEL     500
+
+// Short moves (e.g. Y_MOVE hops) never get near max speed, so their time is
+// set by acceleration alone. Moves up to SHORT_MOVE_STEPS use a separately
+// calibrated, higher acceleration. Calibrate per machine: raise until steps
+// are lost on a short hop, then back off ~30%.
+#define SHORT_MOVE_STEPS 400
+#define X_SHORT_ACCEL    1500
+#define Y_SHORT_ACCEL    2000
+
+// Input shaping per axis (SHAPER_NONE / SHAPER_ZV / SHAPER_ZVD from
+// inputShaper.h). Measure the gantry ringing frequency after a stop (e.g.
+// accelerometer or high-speed video) and its decay for the damping ratio.
+// ZV adds Td/2 to every move, ZVD adds Td (Td = 1 / freq for light damping).
+#define X_SHAPER_TYPE    0      // 0 = off
+#define X_SHAPER_FREQ    18.0   // Hz
+#define X_SHAPER_DAMPING 0.08
+#define Y_SHAPER_TYPE    0      // 0 = off
+#define Y_SHAPER_FREQ    25.0   // Hz
+#define Y_SHAPER_DAMPING 0.06
+
+// Resonance speed bands {lo, hi} in steps/s. Moves never cruise inside a
+// band (the cruise speed drops to its lower edge) and ramps that pass through
+// one use BAND_ACCEL_FACTOR x the move's acceleration while inside it.
+// With the bands listed, X_MAX_SPEED / Y_MAX_SPEED can be raised above them.
+// #define X_SPEED_BANDS { { 1800, 2600 } }
+// #define Y_SPEED_BANDS { { 2200, 3000 } }
+#define BAND_ACCEL_FACTOR 4.0
@@ -0,0 +1,363 @@
+#include "functions.h"
+
+/*
+  Motion service (see motionService.h).
+
+  Per axis the service remembers the last target, position and speed it
+  saw. A step is detected as a position change after the AccelStepper call;
+  its time is taken as this pass's micros() read, which is no later than the
+  one AccelStepper stamped, so now + 1e6 / |speed| never overshoots the real
+  deadline. AccelStepper recomputes the speed only on a step, moveTo() or a
+  limit change; the last two are caught by comparing target and speed.
+  Without an observed step the axis is called every pass, as before.
+
+  Driver power uses the same clock read: the idle time is counted from the
+  last pass with motion pending, and the wake-up delay is reported as the
+  next deadline so background work can use it.
+
+  Coarse travel: a driver whose step mode changes moves to the next state
+  that is valid in the new mode on its next step. Fine positions that are
+  multiples of MICROSTEP_RATIO are kept on valid coarse states, so the first
+  coarse step from fine position s lands on the next multiple in the move's
+  direction: s is converted with floor (forward) or ceil (backward), and the
+  coarse target is the last multiple before the real one. An axis that made
+  no coarse step keeps its fine position. The limit switch trips at any
+  indexer state, so autoHome() calls motionAlignHome() there: one coarse
+  step puts every driver on a coarse-valid state, which then becomes zero.
+  The coarse part cruises at MICROSTEP_SPEED_X / _Y rather than at the fine
+  limit, through the speed bands like any travel (bandCruiseSpeed() on the
+  fine distance, then converted; with KEEPOUT_ZONES as shares of one path
+  speed like the fine limits); the acceleration stays the same physically.
+
+  Fine tail: at most MICROSTEP_RATIO - 1 steps from rest. AccelStepper's
+  first interval is c0 = 0.676 * sqrt(2 / accel) and no later one of such a
+  short move is longer, while the first step is taken at once, so n steps
+  take at most (n - 1) * c0.
+*/
+
+#define MOTION_AXES 3
+
+struct MotionAxis {
+    AccelStepper* m;
+    long          target;  // target at the last pass
+    long          pos;     // position after the last pass
+    float         speed;   // speed the due time was computed from
+    unsigned long stepAt;  // pass time of the last observed step
+    unsigned long due;     // next call not before this (micros())
+};
+
+static MotionAxis gAxis[MOTION_AXES] = {
+    { &motorX1, 0, 0, 0, 0, 0 },
+    { &motorX2, 0, 0, 0, 0, 0 },
+    { &motorY,  0, 0, 0, 0, 0 },
+};
+
+static uint8_t       gFollow  = 0;      // MOTION_* bits in follow mode
+static bool          gHaveDue = false;
+static unsigned long gNextDue = 0;
+
+// Driver power
+static bool          gEnabled   = true;   // setup() enables the drivers
+static bool          gWaking    = false;  // enabled, first step not yet allowed
+static unsigned long gWakeAt    = 0;      // micros() when the drivers were enabled
+static unsigned long gIdleSince = 0;      // micros() of the last pass with motion
+static unsigned long gIdleUs    = 0;      // 0 = never disable
+
+#ifdef MICROSTEP_PIN
+static bool  gCoarse = false;            // drivers coarse, motor units coarse
+static long  gFineStart[MOTION_AXES];    // fine position when the move started
+static long  gCoarseStart[MOTION_AXES];  // the same in coarse units
+static long  gFineTarget[MOTION_AXES];
+static float gFineMaxSpeed[MOTION_AXES];
+static float gFineAccel[MOTION_AXES];
+
+// Floor / ceil division for signed positions
+static long divFloor(long v, long d) { return v >= 0 ? v / d : -((-v + d - 1) / d); }
+static long divCeil(long v, long d)  { return -divFloor(-v, d); }
+#endif
+
+static void driversOn(unsigned long now) {
+    digitalWrite(ENABLE_PIN, LOW);
+    gEnabled = true;
+    gWaking  = true;
+    gWakeAt  = now;
+}
+
+// Pending motion: a target to reach, or (ramped) a speed still to shed
+static bool axisBusy(uint8_t i) {
+    AccelStepper& m = *gAxis[i].m;
+    if (m.distanceToGo() != 0) {
+        return true;
+    }
+    return !(gFollow & (1 << i)) && m.speed() != 0;
+}
+
+static bool anyAxisBusy() {
+    for (uint8_t i = 0; i < MOTION_AXES; i++) {
+        if (axisBusy(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef MICROSTEP_PIN
+// Coarse part done: back to fine steps and fine units, on to the real targets
+static void coarseEnd() {
+    digitalWrite(MICROSTEP_PIN, HIGH);
+    for (uint8_t i = 0; i < MOTION_AXES; i++) {
+        AccelStepper& m = *gAxis[i].m;
+        long c = m.currentPosition();
+        m.setCurrentPosition(c == gCoarseStart[i] ? gFineStart[i] : c * MICROSTEP_RATIO);
+        m.setMaxSpeed(gFineMaxSpeed[i]);
+        m.setAcceleration(gFineAccel[i]);
+        m.moveTo(gFineTarget[i]);
+    }
+    gCoarse = false;
+}
+#endif
+
+static unsigned long stepDue(unsigned long from, float speed, unsigned long now) {
+    return speed != 0 ? from + (unsigned long)(1000000.0 / fabs(speed)) : now;
+}
+
+void motionService() {
+    unsigned long now = micros();
+    gHaveDue = false;
+
+#ifdef MICROSTEP_PIN
+    if (gCoarse && !anyAxisBusy()) {
+        coarseEnd();
+    }
+#endif
+
+    if (!anyAxisBusy()) {
+        if (gEnabled && gIdleUs != 0 && now - gIdleSince >= gIdleUs) {
+            digitalWrite(ENABLE_PIN, HIGH);
+            gEnabled = false;
+        }
+        return;
+    }
+    gIdleSince = now;
+
+    if (!gEnabled) {
+        driversOn(now);
+    }
+    if (gWaking) {
+        if (now - gWakeAt < MOTOR_WAKE_US) {
+            gNextDue = gWakeAt + MOTOR_WAKE_US;
+            gHaveDue = true;
+            return;
+        }
+        gWaking = false;
+    }
+
+    for (uint8_t i = 0; i < MOTION_AXES; i++) {
+        if (!axisBusy(i)) {
+            continue;
+        }
+        MotionAxis&   a = gAxis[i];
+        AccelStepper& m = *a.m;
+
+        long  target = m.targetPosition();
+        float v      = m.speed();
+        if (target != a.target) {
+            a.target = target;       // new move: let AccelStepper decide
+            a.speed  = v;
+            a.due    = now;
+        } else if (v != a.speed) {
+            a.speed = v;             // speed changed between steps
+            a.due   = stepDue(a.stepAt, v, now);
+        }
+
+        if ((long)(now - a.due) >= 0) {
+            if (gFollow & (1 << i)) {
+                m.runSpeedToPosition();
+            } else {
+                m.run();
+            }
+            long pos = m.currentPosition();
+            if (pos != a.pos) {
+                a.pos    = pos;
+                a.stepAt = now;
+                a.speed  = m.speed();
+                a.due    = stepDue(now, a.speed, now);
+            }
+        }
+
+        if (!gHaveDue || (long)(a.due - gNextDue) < 0) {
+            gNextDue = a.due;
+            gHaveDue = true;
+        }
+    }
+}
+
+// A new timeout counts from now: entering a menu never powers down at once
+void motionIdleTimeout(unsigned long ms) {
+    unsigned long us = ms * 1000UL;
+    if (us != gIdleUs) {
+        gIdleUs    = us;
+        gIdleSince = micros();
+    }
+}
+
+void motionWake() {
+    gIdleSince = micros();
+    if (!gEnabled) {
+        driversOn(gIdleSince);
+    }
+    if (gWaking) {
+        delayMicroseconds(MOTOR_WAKE_US);
+        gWaking = false;
+    }
+}
+
+bool motionEnabled() {
+    return gEnabled;
+}
+
+void motionFollow(uint8_t axes, bool follow) {
+    if (follow) {
+        gFollow |= axes;
+    } else {
+        gFollow &= ~axes;
+    }
+}
+
+void motionTravel(long x, long y) {
+    long target[MOTION_AXES] = { x, x, y };
+
+#ifdef MICROSTEP_PIN
+    long longest = 0;
+    for (uint8_t i = 0; i < MOTION_AXES; i++) {
+        long d = labs(target[i] - gAxis[i].m->currentPosition());
+        if (d > longest) {
+            longest = d;
+        }
+    }
+    if (longest >= MICROSTEP_MIN_STEPS) {
+        float cruise[MOTION_AXES];
+        for (uint8_t i = 0; i < MOTION_AXES; i++) {
+            AccelStepper& m = *gAxis[i].m;
+            gFineStart[i]    = m.currentPosition();
+            gFineTarget[i]   = target[i];
+            gFineMaxSpeed[i] = m.maxSpeed();
+            gFineAccel[i]    = m.acceleration();
+            cruise[i] = bandCruiseSpeed(i == 2 ? BAND_AXIS_Y : BAND_AXIS_X, target[i] - gFineStart[i],
+                                        i == 2 ? MICROSTEP_SPEED_Y : MICROSTEP_SPEED_X, gFineAccel[i]);
+        }
+#ifdef KEEPOUT_ZONES
+        // Straight line as for the fine limits (startTravel()): the coarse
+        // cruise speeds become shares of one path speed too
+        long  dx = target[0] - gFineStart[0];
+        long  dy = target[2] - gFineStart[2];
+        float ax = gFineAccel[0];
+        float ay = gFineAccel[2];
+        if (dx != 0 && dy != 0) {
+            cruise[0] = MICROSTEP_SPEED_X;
+            cruise[2] = MICROSTEP_SPEED_Y;
+            bandLineLimits(dx, dy, cruise[0], cruise[2], ax, ay);
+            cruise[1] = cruise[0];
+        }
+#endif
+        for (uint8_t i = 0; i < MOTION_AXES; i++) {
+            AccelStepper& m = *gAxis[i].m;
+            long s = gFineStart[i];
+            bool fwd = target[i] >= s;
+            gCoarseStart[i] = fwd ? divFloor(s, MICROSTEP_RATIO) : divCeil(s, MICROSTEP_RATIO);
+
+            long ct = fwd ? divFloor(target[i], MICROSTEP_RATIO) : divCeil(target[i], MICROSTEP_RATIO);
+            m.setCurrentPosition(gCoarseStart[i]);
+            m.setMaxSpeed(cruise[i] / MICROSTEP_RATIO);
+            m.setAcceleration(gFineAccel[i] / MICROSTEP_RATIO);
+            m.moveTo(ct);
+        }
+        digitalWrite(MICROSTEP_PIN, LOW);
+        gCoarse = true;
+        return;
+    }
+#endif
+
+    for (uint8_t i = 0; i < MOTION_AXES; i++) {
+        gAxis[i].m->moveTo(target[i]);
+    }
+}
+
+void motionAlignHome() {
+#ifdef MICROSTEP_PIN
+    const long away[MOTION_AXES] = { HOME_BACKOFF_X > 0 ? 1 : -1, HOME_BACKOFF_X > 0 ? 1 : -1,
+                                     HOME_BACKOFF_Y > 0 ? 1 : -1 };
+    digitalWrite(MICROSTEP_PIN, LOW);
+    delayMicroseconds(MOTOR_WAKE_US);   // mode pins settle before the step
+    for (uint8_t i = 0; i < MOTION_AXES; i++) {
+        AccelStepper& m = *gAxis[i].m;
+        m.runToNewPosition(m.currentPosition() + away[i]);
+    }
+    digitalWrite(MICROSTEP_PIN, HIGH);
+    delayMicroseconds(MOTOR_WAKE_US);
+#endif
+}
+
+bool motionCoarse() {
+#ifdef MICROSTEP_PIN
+    return gCoarse;
+#else
+    return false;
+#endif
+}
+
+float motionTailMs(uint8_t axes) {
+#ifdef MICROSTEP_PIN
+    float tail = 0;
+    for (uint8_t i = 0; gCoarse && i < MOTION_AXES; i++) {
+        if (!(axes & (1 << i))) {
+            continue;
+        }
+        long ct   = gAxis[i].m->targetPosition();
+        long from = ct == gCoarseStart[i] ? gFineStart[i] : ct * MICROSTEP_RATIO;
+        long n    = labs(gFineTarget[i] - from);
+        if (n > 1) {
+            float c0Ms = 676.0 * sqrt(2.0 / gFineAccel[i]);
+            tail = max(tail, (n - 1) * c0Ms);
+        }
+    }
+    return tail;
+#else
+    (void)axes;
+    return 0;
+#endif
+}
+
+bool motionBusy(uint8_t axes) {
+#ifdef MICROSTEP_PIN
+    if (gCoarse) {
+        // An axis of the travel is done only after its fine part, which
+        // starts once every axis has finished coarse; the others are free
+        for (uint8_t i = 0; i < MOTION_AXES; i++) {
+            if ((axes & (1 << i)) && (gFineTarget[i] != gFineStart[i] || axisBusy(i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+#endif
+    for (uint8_t i = 0; i < MOTION_AXES; i++) {
+        if ((axes & (1 << i)) && axisBusy(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool motionNextDue(unsigned long& due) {
+    due = gNextDue;
+    return gHaveDue;
+}
+
+unsigned long motionSlackUs() {
+    if (!gHaveDue) {
+        return MOTION_NO_DEADLINE;
+    }
+    long left = (long)(gNextDue - micros());
+    return left > 0 ? (unsigned long)left : 0;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Single stepping point for all stepper axes.
+ *
+ * motionService() is called once per loop pass (fsmUpdate()) and is the only
+ * place the FSM steps the motors; handlers just set targets and speeds and
+ * watch distanceToGo(). Each pass reads micros() once for its own
+ * scheduling and calls into AccelStepper only for axes that have motion
+ * pending and whose next step is due (AccelStepper still reads micros()
+ * itself inside each call it gets). The due time is kept from the last
+ * observed step and the axis speed, and is never later than AccelStepper's
+ * own, so skipping does not change step timing. A new target or speed makes the axis due at once.
+ *
+ * Axes normally run ramped moves (AccelStepper::run()). Axes in follow mode
+ * step at the constant speed their owner set (runSpeedToPosition()): the
+ * input-shaped moves and the path planner.
+ *
+ * Driver power: with an idle timeout set (motionIdleTimeout()), the drivers
+ * are disabled (ENABLE_PIN) once every axis has been at rest that long. As
+ * soon as an axis has motion pending they are enabled again and the first
+ * step waits MOTOR_WAKE_US. Positions are kept: the drivers' step indexers
+ * keep their state while disabled, so an unloaded axis comes back on the
+ * same step. Use a timeout only where nothing pushes the axes (menus).
+ *
+ * Microstep switching (MICROSTEP_PIN): motionTravel() runs long moves with
+ * all drivers at MICROSTEP_RATIO times coarser steps, so the pulse rate for
+ * a given speed drops by that ratio and the bulk cruises at
+ * MICROSTEP_SPEED_X / _Y, above the fine step-rate limit. It then switches
+ * back and finishes the last part in fine steps. While coarse, positions, speeds and targets of
+ * the motors are in coarse units; code that reads them mid-move must only
+ * use ratios (distance / speed) or motionBusy(). Positions are fine steps
+ * again once the move is done.
+ */
+
+#define MOTION_X1  0x01
+#define MOTION_X2  0x02
+#define MOTION_Y   0x04
+#define MOTION_X   (MOTION_X1 | MOTION_X2)
+#define MOTION_ALL (MOTION_X | MOTION_Y)
+
+/**
+ * @brief Steps every axis that is due. Call once per loop pass.
+ */
+void motionService();
+
+/**
+ * @brief Disables the drivers after ms without motion (0 = always enabled).
+ * Call every pass; a changed value restarts the idle time.
+ */
+void motionIdleTimeout(unsigned long ms);
+
+/**
+ * @brief Enables the drivers and waits MOTOR_WAKE_US if they were off.
+ * For blocking code that steps without motionService() (homing search).
+ */
+void motionWake();
+
+/**
+ * @brief True while the drivers are enabled (ENABLE_PIN LOW).
+ */
+bool motionEnabled();
+
+/**
+ * @brief Starts a ramped move of the X gantry to x and Y to y (fine steps)
+ * at the motors' current maxSpeed() / acceleration(), coarse for the bulk
+ * if MICROSTEP_PIN is set and the move is at least MICROSTEP_MIN_STEPS long.
+ * Call at rest, with neither axis in follow mode. Done when !motionBusy().
+ */
+void motionTravel(long x, long y);
+
+/**
+ * @brief Puts every driver on a coarse-valid step with one coarse step away
+ * from the limit switches (MICROSTEP_PIN only; no-op otherwise). Call at the
+ * switches, before zeroing, so fine positions that are multiples of
+ * MICROSTEP_RATIO stay coarse-valid.
+ */
+void motionAlignHome();
+
+/**
+ * @brief True while a motionTravel() move runs coarse (motor units coarse).
+ */
+bool motionCoarse();
+
+/**
+ * @brief Upper bound on the time (ms) the fine part of a coarse
+ * motionTravel() still adds for the given axes once the coarse part has
+ * stopped; 0 when not coarse.
+ */
+float motionTailMs(uint8_t axes);
+
+/**
+ * @brief Switches axes between ramped moves and follow mode.
+ */
+void motionFollow(uint8_t axes, bool follow);
+
+/**
+ * @brief True while any of the given axes has motion pending. During a
+ * coarse motionTravel() an axis that moves in it counts as busy until its
+ * fine part is done; an axis that does not move in it is free.
+ */
+bool motionBusy(uint8_t axes);
+
+/**
+ * @brief Earliest next-step deadline (micros()) seen by the last pass.
+ * @return false if no axis was moving.
+ */
+bool motionNextDue(unsigned long& due);
+
+/**
+ * @brief Time left until the next step is due (us): 0 if it is overdue,
+ * MOTION_NO_DEADLINE if no axis was moving. Valid right after motionService().
+ */
+unsigned long motionSlackUs();
+
+#define MOTION_NO_DEADLINE 0xffffffffUL
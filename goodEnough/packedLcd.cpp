@@ -0,0 +1,369 @@
+#include "packedLcd.h"
+
+/*
+  HD44780-over-PCF8574 backend with packed transfers.
+
+  Every HD44780 byte is sent as two 4-bit nibbles on P4..P7. For each nibble
+  we emit two expander bytes:
+      [data | EN]   -> data set up while EN is high
+      [data]        -> falling edge of EN latches the nibble
+  so one character costs 4 expander bytes. These are collected in _tx and sent
+  in one Wire transmission whenever the buffer is full or a call finishes.
+
+  Staged rows: the shadow is ahead of the display only inside the _stage
+  spans; everything else on the display matches the shadow. flushStaged()
+  writes from the shadow, so a staged span overwritten directly in the
+  meantime is simply sent again with the same text. A staged cursor or
+  blink change goes out with the next staged row (which already ends on the
+  logical cursor), or on its own once no row is left. Direct calls made in
+  the meantime only make it resend the current state.
+*/
+
+// HD44780 commands / flags
+#define CMD_CLEAR          0x01
+#define CMD_ENTRY_MODE     0x04
+#define CMD_DISPLAY_CTRL   0x08
+#define CMD_FUNCTION_SET   0x20
+#define CMD_SET_DDRAM      0x80
+
+#define ENTRY_LEFT         0x02
+#define DISPLAY_ON         0x04
+#define CURSOR_ON          0x02
+#define BLINK_ON           0x01
+#define FUNC_2LINE         0x08
+
+// DDRAM start address of each row on a 20x4 module
+static const uint8_t kRowOffsets[4] = { 0x00, 0x40, 0x14, 0x54 };
+
+PackedLcd::PackedLcd(uint8_t addr, uint8_t cols, uint8_t rows)
+    : _addr(addr),
+      _cols(cols > PLCD_MAX_COLS ? PLCD_MAX_COLS : cols),
+      _rows(rows > PLCD_MAX_ROWS ? PLCD_MAX_ROWS : rows),
+      _backlight(PLCD_BACKLIGHT), _displayControl(DISPLAY_ON), _txLen(0),
+      _curCol(0), _curRow(0), _cleared(true), _cursorChanged(true), _cursorStaged(false),
+      _controlStaged(false) {
+    memset(_shadow, ' ', sizeof(_shadow));
+    memset(_dirtyLo, 0xff, sizeof(_dirtyLo));
+    memset(_dirtyHi, 0, sizeof(_dirtyHi));
+    memset(_stageLo, 0xff, sizeof(_stageLo));
+    memset(_stageHi, 0, sizeof(_stageHi));
+}
+
+/*
+  init():
+  Standard HD44780 "initialization by instruction" into 4-bit mode.
+  The first nibbles are sent one at a time because the controller needs
+  long waits between them; after that everything goes through the packed path.
+*/
+void PackedLcd::init() {
+    Wire.begin();
+
+    delay(50);                 // >40 ms after Vcc rises
+    writeNibbleNow(0x30);
+    delayMicroseconds(4500);
+    writeNibbleNow(0x30);
+    delayMicroseconds(4500);
+    writeNibbleNow(0x30);
+    delayMicroseconds(150);
+    writeNibbleNow(0x20);      // switch to 4-bit interface
+
+    command(CMD_FUNCTION_SET | FUNC_2LINE);
+    _displayControl = DISPLAY_ON;
+    command(CMD_DISPLAY_CTRL | _displayControl);
+    command(CMD_ENTRY_MODE | ENTRY_LEFT);
+    clear();
+}
+
+void PackedLcd::backlight() {
+    _backlight = PLCD_BACKLIGHT;
+    Wire.beginTransmission(_addr);
+    Wire.write(_backlight);
+    Wire.endTransmission();
+}
+
+void PackedLcd::noBacklight() {
+    _backlight = 0;
+    Wire.beginTransmission(_addr);
+    Wire.write(_backlight);
+    Wire.endTransmission();
+}
+
+void PackedLcd::clear() {
+    command(CMD_CLEAR);
+    delayMicroseconds(2000);   // clear/home take 1.52 ms on the controller
+
+    memset(_shadow, ' ', sizeof(_shadow));
+    memset(_dirtyLo, 0xff, sizeof(_dirtyLo));
+    memset(_dirtyHi, 0, sizeof(_dirtyHi));
+    memset(_stageLo, 0xff, sizeof(_stageLo));  // nothing left to send on a blank screen
+    memset(_stageHi, 0, sizeof(_stageHi));
+    _cleared      = true;
+    _cursorStaged = false;   // the clear command homes the cursor
+    shadowCursor(0, 0);
+}
+
+void PackedLcd::setCursor(uint8_t col, uint8_t row) {
+    queueCursor(col, row);
+    flush();
+}
+
+void PackedLcd::display()   { _displayControl |=  DISPLAY_ON; command(CMD_DISPLAY_CTRL | _displayControl); }
+void PackedLcd::noDisplay() { _displayControl &= ~DISPLAY_ON; command(CMD_DISPLAY_CTRL | _displayControl); }
+void PackedLcd::cursor()    { _displayControl |=  CURSOR_ON;  command(CMD_DISPLAY_CTRL | _displayControl); }
+void PackedLcd::noCursor()  { _displayControl &= ~CURSOR_ON;  command(CMD_DISPLAY_CTRL | _displayControl); }
+void PackedLcd::blink()     { _displayControl |=  BLINK_ON;   command(CMD_DISPLAY_CTRL | _displayControl); _cursorChanged = true; }
+void PackedLcd::noBlink()   { _displayControl &= ~BLINK_ON;   command(CMD_DISPLAY_CTRL | _displayControl); _cursorChanged = true; }
+
+/*
+  printLine():
+  Cursor move + full-width row in one burst (21 HD44780 bytes -> 84 expander
+  bytes -> 3 Wire transmissions with the stock 32-byte buffer).
+*/
+void PackedLcd::printLine(uint8_t row, const char* msg) {
+    queueCursor(0, row);
+    for (uint8_t col = 0; col < _cols; col++) {
+        char c = *msg;
+        if (c != '\0') {
+            msg++;
+        } else {
+            c = ' ';
+        }
+        queueByte((uint8_t)c, PLCD_RS);
+        shadowPut((uint8_t)c);
+    }
+    flush();
+}
+
+void PackedLcd::stageLine(uint8_t row, const char* msg) {
+    if (row >= _rows) {
+        return;
+    }
+    for (uint8_t col = 0; col < _cols; col++) {
+        char c = *msg;
+        if (c != '\0') {
+            msg++;
+        } else {
+            c = ' ';
+        }
+        if (shadowSet(row, col, c)) {
+            if (col < _stageLo[row]) _stageLo[row] = col;
+            if (col > _stageHi[row]) _stageHi[row] = col;
+        }
+    }
+}
+
+void PackedLcd::stageClear() {
+    for (uint8_t row = 0; row < _rows; row++) {
+        stageLine(row, "");
+    }
+    stageCursor(0, 0);
+}
+
+void PackedLcd::stageCursor(uint8_t col, uint8_t row) {
+    if (row >= _rows) {
+        row = _rows - 1;
+    }
+    shadowCursor(col, row);
+    _cursorStaged = true;
+}
+
+void PackedLcd::stageBlink(bool on) {
+    if (on) {
+        _displayControl |= BLINK_ON;
+    } else {
+        _displayControl &= ~BLINK_ON;
+    }
+    _controlStaged = true;
+    _cursorChanged = true;
+}
+
+/*
+  flushStaged():
+  One DDRAM address command, the characters, and an address command back to
+  the logical cursor, so direct writes that follow still land where expected.
+*/
+bool PackedLcd::flushStaged(uint8_t maxChars) {
+    for (uint8_t row = 0; row < _rows; row++) {
+        if (_stageLo[row] > _stageHi[row]) {
+            continue;
+        }
+        uint8_t lo = _stageLo[row];
+        uint8_t hi = _stageHi[row];
+        if (hi - lo + 1 > maxChars) {
+            hi = lo + maxChars - 1;
+        }
+
+        queueByte(CMD_SET_DDRAM | (lo + kRowOffsets[row & 3]), 0);
+        for (uint8_t col = lo; col <= hi; col++) {
+            queueByte((uint8_t)_shadow[row][col], PLCD_RS);
+        }
+        queueByte(CMD_SET_DDRAM | (_curCol + kRowOffsets[_curRow & 3]), 0);
+        flush();
+        _cursorStaged = false;
+
+        if (hi == _stageHi[row]) {
+            _stageLo[row] = 0xff;
+            _stageHi[row] = 0;
+        } else {
+            _stageLo[row] = hi + 1;
+        }
+        return staged();
+    }
+
+    if (_controlStaged) {
+        queueByte(CMD_DISPLAY_CTRL | _displayControl, 0);
+    }
+    if (_cursorStaged) {
+        queueByte(CMD_SET_DDRAM | (_curCol + kRowOffsets[_curRow & 3]), 0);
+    }
+    flush();
+    _controlStaged = false;
+    _cursorStaged  = false;
+    return false;
+}
+
+bool PackedLcd::staged() const {
+    for (uint8_t row = 0; row < _rows; row++) {
+        if (_stageLo[row] <= _stageHi[row]) {
+            return true;
+        }
+    }
+    return _cursorStaged || _controlStaged;
+}
+
+size_t PackedLcd::write(uint8_t c) {
+    queueByte(c, PLCD_RS);
+    shadowPut(c);
+    flush();
+    return 1;
+}
+
+size_t PackedLcd::write(const uint8_t* buf, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        queueByte(buf[i], PLCD_RS);
+        shadowPut(buf[i]);
+    }
+    flush();
+    return size;
+}
+
+// ---------------- Shadow copy ----------------
+
+bool PackedLcd::dirtySpan(uint8_t row, uint8_t& lo, uint8_t& hi) const {
+    if (row >= _rows || _dirtyLo[row] > _dirtyHi[row]) {
+        return false;
+    }
+    lo = _dirtyLo[row];
+    hi = _dirtyHi[row];
+    return true;
+}
+
+void PackedLcd::clearDirty(uint8_t row) {
+    _dirtyLo[row] = 0xff;
+    _dirtyHi[row] = 0;
+}
+
+bool PackedLcd::takeCleared() {
+    bool c = _cleared;
+    _cleared = false;
+    return c;
+}
+
+bool PackedLcd::takeCursorChanged() {
+    bool c = _cursorChanged;
+    _cursorChanged = false;
+    return c;
+}
+
+void PackedLcd::markAllDirty() {
+    _cleared = true;
+    for (uint8_t r = 0; r < _rows; r++) {
+        _dirtyLo[r] = 0;
+        _dirtyHi[r] = _cols - 1;
+    }
+    _cursorChanged = true;
+}
+
+/*
+  shadowPut():
+  Mirrors one character written at the cursor. The HD44780 keeps writing past
+  the end of a row into unrelated DDRAM, so characters beyond the last column
+  are dropped here.
+*/
+void PackedLcd::shadowPut(uint8_t c) {
+    if (_curCol < _cols) {
+        shadowSet(_curRow, _curCol, (char)c);
+    }
+    _curCol++;
+    _cursorChanged = true;
+}
+
+// Sets one shadow character; returns true (and marks it dirty) if it changed
+bool PackedLcd::shadowSet(uint8_t row, uint8_t col, char c) {
+    if (_shadow[row][col] == c) {
+        return false;
+    }
+    _shadow[row][col] = c;
+    if (col < _dirtyLo[row]) _dirtyLo[row] = col;
+    if (col > _dirtyHi[row]) _dirtyHi[row] = col;
+    return true;
+}
+
+void PackedLcd::shadowCursor(uint8_t col, uint8_t row) {
+    if (col != _curCol || row != _curRow) {
+        _curCol = col;
+        _curRow = row;
+        _cursorChanged = true;
+    }
+}
+
+// ---------------- Internal helpers ----------------
+
+void PackedLcd::command(uint8_t cmd) {
+    queueByte(cmd, 0);
+    flush();
+}
+
+/*
+  queueByte():
+  Appends the 4 expander bytes for one HD44780 byte. Flushes first if the
+  transmission buffer cannot hold them.
+*/
+void PackedLcd::queueByte(uint8_t value, uint8_t mode) {
+    if (_txLen + 4 > PLCD_TX_BUFFER) {
+        flush();
+    }
+    uint8_t hi = (value & 0xF0)        | mode | _backlight;
+    uint8_t lo = ((value << 4) & 0xF0) | mode | _backlight;
+    _tx[_txLen++] = hi | PLCD_EN;
+    _tx[_txLen++] = hi;
+    _tx[_txLen++] = lo | PLCD_EN;
+    _tx[_txLen++] = lo;
+}
+
+void PackedLcd::queueCursor(uint8_t col, uint8_t row) {
+    if (row >= _rows) {
+        row = _rows - 1;
+    }
+    queueByte(CMD_SET_DDRAM | (col + kRowOffsets[row & 3]), 0);
+    shadowCursor(col, row);
+}
+
+// Single nibble with its own transmission; only used during init().
+void PackedLcd::writeNibbleNow(uint8_t nibble) {
+    uint8_t b = (nibble & 0xF0) | _backlight;
+    Wire.beginTransmission(_addr);
+    Wire.write(b | PLCD_EN);
+    Wire.write(b);
+    Wire.endTransmission();
+}
+
+void PackedLcd::flush() {
+    if (_txLen == 0) {
+        return;
+    }
+    Wire.beginTransmission(_addr);
+    Wire.write(_tx, _txLen);
+    Wire.endTransmission();
+    _txLen = 0;
+}
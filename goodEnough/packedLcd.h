@@ -0,0 +1,184 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// ---------------- PCF8574 backpack bit layout ----------------
+
+#define PLCD_RS        0x01  // P0: register select (0 = command, 1 = data)
+#define PLCD_RW        0x02  // P1: read/write (always write here)
+#define PLCD_EN        0x04  // P2: enable strobe (HD44780 latches on falling edge)
+#define PLCD_BACKLIGHT 0x08  // P3: backlight transistor
+
+// Shadow copy size (largest supported module)
+#define PLCD_MAX_COLS 20
+#define PLCD_MAX_ROWS 4
+
+// Wire's internal buffer caps how many expander bytes fit in one transmission
+#ifdef BUFFER_LENGTH
+#define PLCD_TX_BUFFER BUFFER_LENGTH
+#else
+#define PLCD_TX_BUFFER 32
+#endif
+
+/**
+ * @brief HD44780 20x4 driver over a PCF8574 I2C backpack.
+ *
+ * Drop-in for the subset of LiquidCrystal_I2C used by the FSM, but every
+ * nibble + enable strobe is packed into a local buffer and sent in as few
+ * Wire transmissions as the buffer allows (4 expander bytes per character,
+ * 8 characters per transmission) instead of 6 separate transmissions with
+ * 50 us delays per character.
+ *
+ * No busy-flag polling or delays are needed between characters: at
+ * 100-400 kHz each expander byte takes longer on the bus than the 37 us
+ * HD44780 execution time.
+ *
+ * A shadow copy of the screen (text, cursor, blink) is kept with per-row
+ * dirty spans, so the screen can be mirrored elsewhere (remote UI) by sending
+ * only what changed. Writes that do not change a character leave it clean.
+ *
+ * Rows can also be staged (stageLine()): only the shadow changes, and the
+ * bus transfer is done later in small chunks by flushStaged(), so a row
+ * update never holds the loop for a whole row transfer. A clear, a cursor
+ * move and the blink state can be staged the same way (stageClear(),
+ * stageCursor(), stageBlink()); a staged clear blanks the rows character by
+ * character instead of holding the loop ~2 ms for the clear command.
+ */
+class PackedLcd : public Print {
+public:
+    PackedLcd(uint8_t addr, uint8_t cols, uint8_t rows);
+
+    /**
+     * @brief Starts Wire and runs the HD44780 4-bit init sequence (blocking, ~60 ms).
+     */
+    void init();
+
+    void backlight();
+    void noBacklight();
+
+    /**
+     * @brief Clears the display and homes the cursor (blocks ~2 ms for the controller).
+     */
+    void clear();
+    void setCursor(uint8_t col, uint8_t row);
+
+    void display();
+    void noDisplay();
+    void cursor();
+    void noCursor();
+    void blink();
+    void noBlink();
+
+    /**
+     * @brief Writes a whole row: cursor move + msg padded with spaces to the
+     * full width, in one buffered burst. Long messages are truncated.
+     */
+    void printLine(uint8_t row, const char* msg);
+
+    /**
+     * @brief Like printLine(), but only updates the shadow; the changed
+     * characters are sent by flushStaged(). The cursor does not move.
+     */
+    void stageLine(uint8_t row, const char* msg);
+
+    /**
+     * @brief Staged clear(): blank rows (only the characters that change)
+     * and the cursor home.
+     */
+    void stageClear();
+
+    /**
+     * @brief Staged setCursor(): the logical cursor moves now, the display
+     * cursor with the next flushStaged().
+     */
+    void stageCursor(uint8_t col, uint8_t row);
+
+    /**
+     * @brief Staged blink() / noBlink().
+     */
+    void stageBlink(bool on);
+
+    /**
+     * @brief Sends up to maxChars staged characters in one transmission
+     * (maxChars <= 6 with the stock 32-byte Wire buffer), or else a staged
+     * cursor / blink change.
+     * @return true while staged characters remain.
+     */
+    bool flushStaged(uint8_t maxChars);
+
+    /**
+     * @brief True while staged characters, a cursor move or a blink change
+     * are waiting for flushStaged().
+     */
+    bool staged() const;
+
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t* buf, size_t size);
+    using Print::write;
+
+    // ---------------- Shadow copy (screen mirroring) ----------------
+
+    /**
+     * @brief Current text of a row (PLCD_MAX_COLS chars, not NUL-terminated).
+     */
+    const char* shadowRow(uint8_t row) const { return _shadow[row]; }
+
+    /**
+     * @brief Changed column range [lo, hi] of a row since clearDirty().
+     * @return false if the row is clean.
+     */
+    bool dirtySpan(uint8_t row, uint8_t& lo, uint8_t& hi) const;
+    void clearDirty(uint8_t row);
+
+    /**
+     * @brief True once after clear() (mirror should blank its copy).
+     */
+    bool takeCleared();
+
+    /**
+     * @brief True once after the cursor position or blink state changed.
+     */
+    bool takeCursorChanged();
+
+    /**
+     * @brief Marks everything dirty so a mirror can resync from scratch.
+     */
+    void markAllDirty();
+
+    uint8_t cursorCol() const { return _curCol; }
+    uint8_t cursorRow() const { return _curRow; }
+    bool    blinking()  const { return (_displayControl & 0x01) != 0; }
+
+private:
+    void shadowPut(uint8_t c);
+    void shadowCursor(uint8_t col, uint8_t row);
+    bool shadowSet(uint8_t row, uint8_t col, char c);
+
+    void command(uint8_t cmd);
+    void queueByte(uint8_t value, uint8_t mode);
+    void queueCursor(uint8_t col, uint8_t row);
+    void writeNibbleNow(uint8_t nibble);
+    void flush();
+
+    uint8_t _addr;
+    uint8_t _cols;
+    uint8_t _rows;
+    uint8_t _backlight;      // PLCD_BACKLIGHT or 0, OR'd into every expander byte
+    uint8_t _displayControl; // last HD44780 display-control flags (D/C/B)
+
+    uint8_t _tx[PLCD_TX_BUFFER];
+    uint8_t _txLen;
+
+    char    _shadow[PLCD_MAX_ROWS][PLCD_MAX_COLS];
+    uint8_t _dirtyLo[PLCD_MAX_ROWS]; // lo > hi means clean
+    uint8_t _dirtyHi[PLCD_MAX_ROWS];
+    uint8_t _stageLo[PLCD_MAX_ROWS]; // shadow ahead of the display; lo > hi means none
+    uint8_t _stageHi[PLCD_MAX_ROWS];
+    uint8_t _curCol;
+    uint8_t _curRow;
+    bool    _cleared;
+    bool    _cursorChanged;
+    bool    _cursorStaged;   // display cursor behind _curCol / _curRow
+    bool    _controlStaged;  // display behind _displayControl
+};
@@ -0,0 +1,321 @@
+#include "functions.h"
+
+/*
+  Path planner internals.
+
+  Queue:    small ring buffer of primitives (line / arc) filled by the public API.
+  Chord:    the straight piece currently being executed (every axis in
+            follow mode, speeds set so all axes arrive together).
+  Arc gen:  when an arc primitive is popped, its chord end points are produced
+            one at a time by arcNext() (arcGen.h); only one chord is live at a
+            time, so RAM use does not depend on arc length. A mapped arc is
+            cut in nominal coordinates and every chord end point goes through
+            correctionApply().
+  Ramp:     one path speed for the whole run, updated every PATH_UPDATE_US:
+            it rises at PATH_ACCEL up to the segment's feed and is capped by
+            profileBrakeSpeed() towards every segment start ahead (its vIn)
+            and towards the end of the queue (PATH_START_SPEED). Segment
+            lengths are worked out when they are queued, so the look-ahead is
+            a few additions and square roots per update.
+  Corners:  a segment's vIn is also capped by profileJunctionSpeed(): the
+            direction change where it joins the previous one may change no
+            axis speed by more than PATH_START_SPEED, the step the axes take
+            from rest. A full reversal is thus taken at half that speed,
+            which is the lowest the ramp ever goes.
+*/
+
+enum PathSegType {
+    PATH_LINE = 0,
+    PATH_ARC
+};
+
+struct PathSeg {
+    uint8_t type;   // PathSegType
+    bool    ccw;    // arcs only
+    bool    mapped; // arcs only: nominal coordinates, chords corrected
+    long    x, y;   // end point (absolute steps)
+    long    cx, cy; // arc center (absolute steps)
+    float   feed;   // path speed (steps/s)
+    float   len;    // path length (steps)
+    float   vIn;    // highest path speed where the segment starts
+};
+
+static PathSeg gQueue[PATH_QUEUE_LEN];
+static uint8_t gQueueHead  = 0;  // next entry to execute
+static uint8_t gQueueCount = 0;
+
+// End of the last queued segment (machine steps): where the next one
+// starts, and the direction it ends in
+static long  gTailX  = 0;
+static long  gTailY  = 0;
+static float gTailUx = 0;
+static float gTailUy = 0;
+
+// Active chord
+static bool  gChordActive = false;
+static float gFeed        = 0;
+static float gUx          = 0;   // chord direction (unit vector)
+static float gUy          = 0;
+
+// Path speed of the run (0 = at rest) and its last update (micros())
+static float         gSpeed  = 0;
+static unsigned long gRampAt = 0;
+
+// Active arc generator (arcGen.h)
+static ArcGen gArc;
+static bool   gArcMapped = false;
+static float  gArcChord  = 0;   // chord length of the active arc
+
+// ---------------- Internal helpers ----------------
+
+static bool queuePush(PathSeg& seg) {
+    if (gQueueCount >= PATH_QUEUE_LEN) {
+        return false;
+    }
+    bool joins = pathBusy();
+    if (!joins) {
+        gTailX = motorX1.currentPosition();
+        gTailY = motorY.currentPosition();
+    }
+
+    // Length, and the directions the segment starts and ends in
+    long  sx = gTailX;
+    long  sy = gTailY;
+    float inUx, inUy, outUx, outUy;
+    if (seg.type == PATH_ARC) {
+        if (seg.mapped) {
+            correctionRemove(sx, sy);
+        }
+        float rx  = (float)(sx - seg.cx);
+        float ry  = (float)(sy - seg.cy);
+        float ex  = (float)(seg.x - seg.cx);
+        float ey  = (float)(seg.y - seg.cy);
+        float r   = sqrt(rx * rx + ry * ry);
+        float re  = sqrt(ex * ex + ey * ey);
+        float dir = seg.ccw ? 1 : -1;
+        seg.len = r * fabs(arcSweep(sx, sy, seg.x, seg.y, seg.cx, seg.cy, seg.ccw));
+        inUx  = r > 0 ? -dir * ry / r : 0;
+        inUy  = r > 0 ? dir * rx / r : 0;
+        outUx = re > 0 ? -dir * ey / re : 0;
+        outUy = re > 0 ? dir * ex / re : 0;
+    } else {
+        float dx = (float)(seg.x - sx);
+        float dy = (float)(seg.y - sy);
+        seg.len = sqrt(dx * dx + dy * dy);
+        inUx = outUx = seg.len > 0 ? dx / seg.len : 0;
+        inUy = outUy = seg.len > 0 ? dy / seg.len : 0;
+    }
+    seg.vIn = seg.feed;
+    if (seg.len > 0) {
+        if (joins) {
+            seg.vIn = min(seg.vIn, profileJunctionSpeed(gTailUx, gTailUy, inUx, inUy, PATH_START_SPEED));
+        }
+        gTailUx = outUx;
+        gTailUy = outUy;
+    }
+
+    gTailX = seg.x;
+    gTailY = seg.y;
+    if (seg.mapped) {
+        correctionApply(gTailX, gTailY);
+    }
+    gQueue[(gQueueHead + gQueueCount) % PATH_QUEUE_LEN] = seg;
+    gQueueCount++;
+    return true;
+}
+
+// Each axis gets its share of the path speed, so all of them finish together
+static void chordSpeed() {
+    motorX1.setSpeed(gSpeed * gUx);
+    motorX2.setSpeed(gSpeed * gUx);
+    motorY.setSpeed(gSpeed * gUy);
+}
+
+/*
+  chordBegin():
+  Commands a straight chord to (x, y) at the current path speed, which never
+  exceeds the feed of the segment it belongs to.
+*/
+static void chordBegin(long x, long y) {
+    long dx = x - motorX1.currentPosition();
+    long dy = y - motorY.currentPosition();
+    float len = sqrt((float)dx * dx + (float)dy * dy);
+
+    motorX1.moveTo(x);
+    motorX2.moveTo(x);
+    motorY.moveTo(y);
+
+    if (len < 0.5) {
+        motorX1.setSpeed(0);
+        motorX2.setSpeed(0);
+        motorY.setSpeed(0);
+        gChordActive = false;
+        return;
+    }
+
+    gUx = dx / len;
+    gUy = dy / len;
+    if (gSpeed > gFeed) {
+        gSpeed = gFeed;
+    }
+    motionFollow(MOTION_ALL, true);
+    chordSpeed();
+    gChordActive = true;
+}
+
+// Pops the next chord target from the arc generator or the queue.
+static bool nextChord() {
+    long x, y;
+
+    if (gArc.active) {
+        arcNext(gArc, x, y);
+        if (gArcMapped) {
+            correctionApply(x, y);
+        }
+        chordBegin(x, y);
+        return true;
+    }
+
+    if (gQueueCount == 0) {
+        return false;
+    }
+
+    PathSeg& seg = gQueue[gQueueHead];
+    gQueueHead = (gQueueHead + 1) % PATH_QUEUE_LEN;
+    gQueueCount--;
+
+    gFeed = seg.feed;
+    if (gSpeed == 0) {
+        gSpeed  = PATH_START_SPEED;   // run starts from rest
+        gRampAt = micros();
+    }
+    if (seg.type == PATH_ARC) {
+        long sx = motorX1.currentPosition();
+        long sy = motorY.currentPosition();
+        if (seg.mapped) {
+            correctionRemove(sx, sy);
+        }
+        arcBegin(gArc, sx, sy, seg.x, seg.y, seg.cx, seg.cy, seg.ccw, ARC_TOLERANCE, ARC_CORRECTION);
+        gArcMapped = seg.mapped;
+        gArcChord  = 2 * gArc.radius * sin(fabs(gArc.step) / 2);
+        arcNext(gArc, x, y);
+        if (gArcMapped) {
+            correctionApply(x, y);
+        }
+    } else {
+        x = seg.x;
+        y = seg.y;
+    }
+    chordBegin(x, y);
+    return true;
+}
+
+/*
+  aheadSpeed():
+  Highest path speed that can still slow to every segment start ahead and
+  stop at the end of the queue. The distance covered until the next update
+  is taken off first, so the limit holds between updates too.
+*/
+static float aheadSpeed() {
+    float dx = (float)motorX1.distanceToGo();
+    float dy = (float)motorY.distanceToGo();
+    float d  = sqrt(dx * dx + dy * dy) - gSpeed * (PATH_UPDATE_US / 1e6);
+    if (gArc.active) {
+        d += (gArc.count - gArc.index) * gArcChord;
+    }
+
+    float v = 1e30;
+    for (uint8_t k = 0; k < gQueueCount; k++) {
+        const PathSeg& seg = gQueue[(gQueueHead + k) % PATH_QUEUE_LEN];
+        v = min(v, profileBrakeSpeed(d, seg.vIn, PATH_ACCEL));
+        d += seg.len;
+    }
+    return min(v, profileBrakeSpeed(d, PATH_START_SPEED, PATH_ACCEL));
+}
+
+// Ramps the path speed (PATH_ACCEL up, aheadSpeed() down) every PATH_UPDATE_US
+static void rampUpdate() {
+    unsigned long now = micros();
+    if (now - gRampAt < PATH_UPDATE_US) {
+        return;
+    }
+    float v = gSpeed + PATH_ACCEL * ((now - gRampAt) / 1e6);
+    gRampAt = now;
+    v = min(v, gFeed);
+    v = min(v, aheadSpeed());
+    gSpeed = max(v, (float)(PATH_START_SPEED / 2));   // lowest corner cap
+    chordSpeed();
+}
+
+// ---------------- Public API ----------------
+
+bool pathLine(long x, long y, float feed) {
+    PathSeg seg;
+    seg.type   = PATH_LINE;
+    seg.ccw    = false;
+    seg.mapped = false;
+    seg.x    = x;
+    seg.y    = y;
+    seg.cx   = 0;
+    seg.cy   = 0;
+    seg.feed = feed;
+    return queuePush(seg);
+}
+
+bool pathArc(long x, long y, long cx, long cy, bool ccw, float feed, bool mapped) {
+    PathSeg seg;
+    seg.type   = PATH_ARC;
+    seg.ccw    = ccw;
+    seg.mapped = mapped;
+    seg.x    = x;
+    seg.y    = y;
+    seg.cx   = cx;
+    seg.cy   = cy;
+    seg.feed = feed;
+    return queuePush(seg);
+}
+
+bool pathRun() {
+    // Zero-length chords finish immediately; skip through them in one call
+    while (!gChordActive) {
+        if (!nextChord()) {
+            return false;
+        }
+    }
+
+    if (motorX1.distanceToGo() == 0 &&
+        motorX2.distanceToGo() == 0 &&
+        motorY.distanceToGo() == 0) {
+        gChordActive = false;
+        if (!gArc.active && gQueueCount == 0) {
+            gSpeed = 0;
+            motorX1.setSpeed(0);
+            motorX2.setSpeed(0);
+            motorY.setSpeed(0);
+            motionFollow(MOTION_ALL, false);
+            return false;
+        }
+        return true;
+    }
+    rampUpdate();
+    return true;
+}
+
+bool pathBusy() {
+    return gChordActive || gArc.active || gQueueCount > 0;
+}
+
+void pathAbort() {
+    gQueueCount  = 0;
+    gArc.active  = false;
+    gChordActive = false;
+    gSpeed       = 0;
+
+    motorX1.setSpeed(0);
+    motorX2.setSpeed(0);
+    motorY.setSpeed(0);
+    motorX1.moveTo(motorX1.currentPosition());
+    motorX2.moveTo(motorX2.currentPosition());
+    motorY.moveTo(motorY.currentPosition());
+    motionFollow(MOTION_ALL, false);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Coordinated XY path execution (lines and G2/G3-style arcs).
+ *
+ * Segments are queued with pathLine()/pathArc() and executed by pathRun(),
+ * which must be called every loop. The X gantry motors (X1/X2) and Y are
+ * driven at per-axis constant speeds (follow mode of motionService()) so that
+ * each chord is a straight line at the requested feed; consecutive chords
+ * are chained without stopping.
+ *
+ * Arcs are cut into chords that stay within ARC_TOLERANCE steps of the
+ * circle (arcGen.h, checked on the host by tools/arcCheck.cpp). Chord end
+ * points come from an incremental fixed-point rotation that is re-anchored
+ * with exact sin/cos every ARC_CORRECTION chords.
+ *
+ * Each segment has a feed (path speed, steps/s). The run starts and ends at
+ * PATH_START_SPEED and ramps at PATH_ACCEL in between (profile.h), slowing
+ * ahead of a segment with a lower feed and of the end of the queue, so only
+ * what is queued is planned for: a segment queued late can only let the
+ * run speed up again.
+ */
+
+/**
+ * @brief Queues a straight move to absolute (x, y).
+ * @return false if the queue is full.
+ */
+bool pathLine(long x, long y, float feed);
+
+/**
+ * @brief Queues an arc from the end of the previous segment to (x, y) around
+ * center (cx, cy). Start == end gives a full circle.
+ * @param ccw true for G3 (counter-clockwise in step space), false for G2.
+ * @param mapped true if (x, y) and (cx, cy) are nominal positions: the arc
+ * is cut where it was programmed and every chord end point goes through
+ * correctionApply(), so it ends on the corrected (x, y).
+ * @return false if the queue is full.
+ */
+bool pathArc(long x, long y, long cx, long cy, bool ccw, float feed, bool mapped);
+
+/**
+ * @brief Advances the active path. Call every loop while pathBusy().
+ * @return true while motion is in progress.
+ */
+bool pathRun();
+
+/**
+ * @brief True while a segment is executing or queued.
+ */
+bool pathBusy();
+
+/**
+ * @brief Drops all queued segments and stops the axes where they are.
+ */
+void pathAbort();
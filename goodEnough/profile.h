@@ -0,0 +1,152 @@
+#pragma once
+
+// Pure motion-profile math (no Arduino dependencies) so the same code can be
+// compiled into host-side tools.
+
+#include <math.h>
+
+/**
+ * @brief Symmetric trapezoidal (or triangular) rest-to-rest move.
+ *
+ * Distances, velocities and accelerations are in any consistent units
+ * (steps, degrees, ...); times are in seconds.
+ */
+struct TrapezoidProfile {
+    float distance;   ///< |move length|
+    float accel;      ///< acceleration = deceleration
+    float peakVel;    ///< cruise speed, or apex speed if the move is triangular
+    float accelTime;  ///< time spent accelerating (same as decelerating)
+    float cruiseTime; ///< time at peakVel (0 for a triangular move)
+    float totalTime;  ///< rest-to-rest duration
+};
+
+/**
+ * @brief Plans a rest-to-rest move of the given length.
+ * A move shorter than maxVel^2 / accel never reaches maxVel (triangular).
+ */
+inline TrapezoidProfile profilePlan(float distance, float maxVel, float accel) {
+    TrapezoidProfile p;
+    p.distance = fabs(distance);
+    p.accel    = accel;
+
+    if (p.distance * accel >= maxVel * maxVel) {
+        p.peakVel    = maxVel;
+        p.accelTime  = maxVel / accel;
+        p.cruiseTime = (p.distance - maxVel * maxVel / accel) / maxVel;
+    } else {
+        p.accelTime  = sqrt(p.distance / accel);
+        p.peakVel    = accel * p.accelTime;
+        p.cruiseTime = 0;
+    }
+    p.totalTime = 2 * p.accelTime + p.cruiseTime;
+    return p;
+}
+
+/**
+ * @brief Distance covered t seconds after the start of the move (0..distance).
+ */
+inline float profilePosition(const TrapezoidProfile& p, float t) {
+    if (t <= 0) {
+        return 0;
+    }
+    if (t >= p.totalTime) {
+        return p.distance;
+    }
+    if (t < p.accelTime) {
+        return 0.5f * p.accel * t * t;
+    }
+    if (t < p.accelTime + p.cruiseTime) {
+        return 0.5f * p.peakVel * p.accelTime + p.peakVel * (t - p.accelTime);
+    }
+    float r = p.totalTime - t;
+    return p.distance - 0.5f * p.accel * r * r;
+}
+
+/**
+ * @brief Distance-aware acceleration choice.
+ * Moves of at most shortMaxDist use shortAccel (they are acceleration-bound
+ * and never cruise), longer moves use longAccel.
+ */
+inline float profileSelectAccel(float distance, float shortMaxDist, float shortAccel, float longAccel) {
+    return (fabs(distance) <= shortMaxDist) ? shortAccel : longAccel;
+}
+
+/**
+ * @brief Speed range an axis must not cruise in (mid-band resonance).
+ */
+struct SpeedBand {
+    float lo;
+    float hi;
+};
+
+/**
+ * @brief Cruise speed limit for a move that must not cruise inside a band.
+ *
+ * The unrestricted peak is min(maxVel, sqrt(distance * accel)). If it falls
+ * inside a band the move is capped at the band's lower edge, otherwise it is
+ * left alone (a peak above a band means the ramps only pass through it).
+ */
+inline float profileBandCruise(float distance, float maxVel, float accel,
+                               const SpeedBand* bands, unsigned char count) {
+    float peak = sqrt(fabs(distance) * accel);
+    if (peak > maxVel) {
+        peak = maxVel;
+    }
+    for (bool moved = true; moved; ) {
+        moved = false;
+        for (unsigned char i = 0; i < count; i++) {
+            if (peak > bands[i].lo && peak < bands[i].hi) {
+                peak  = bands[i].lo;
+                moved = true;
+            }
+        }
+    }
+    return peak < maxVel ? peak : maxVel;
+}
+
+/**
+ * @brief Highest speed from which a move can still slow to vEnd within
+ * distance at the given deceleration: sqrt(vEnd^2 + 2 * accel * distance).
+ * Used as a running limit, it ramps a path down into its end or a slower
+ * part ahead.
+ */
+inline float profileBrakeSpeed(float distance, float vEnd, float accel) {
+    if (distance < 0) {
+        distance = 0;
+    }
+    return sqrt(vEnd * vEnd + 2 * accel * distance);
+}
+
+/**
+ * @brief Corner speed cap: the highest path speed at which turning from
+ * direction (ux0, uy0) to (ux1, uy1) (unit vectors) changes no axis speed
+ * by more than jump. Straight on gives no cap (a huge value).
+ */
+inline float profileJunctionSpeed(float ux0, float uy0, float ux1, float uy1, float jump) {
+    float dx = fabs(ux1 - ux0);
+    float dy = fabs(uy1 - uy0);
+    float d  = dx > dy ? dx : dy;
+    return d > 1e-6f ? jump / d : 1e30f;
+}
+
+/**
+ * @brief Limits for a two-axis move of (dx, dy) that stays on its straight
+ * line: the path speed and acceleration that keep each moving axis within
+ * its own limit (vx / ax, vy / ay on entry), given back as each axis' share.
+ * Both rest-to-rest profiles then have the same timing. An axis that does
+ * not move keeps its limits.
+ */
+inline void profileLineLimits(float dx, float dy, float& vx, float& vy, float& ax, float& ay) {
+    float len = sqrt(dx * dx + dy * dy);
+    if (dx == 0 || dy == 0) {
+        return;
+    }
+    float ux = fabs(dx) / len;
+    float uy = fabs(dy) / len;
+    float v  = vx / ux < vy / uy ? vx / ux : vy / uy;
+    float a  = ax / ux < ay / uy ? ax / ux : ay / uy;
+    vx = v * ux;
+    vy = v * uy;
+    ax = a * ux;
+    ay = a * uy;
+}
@@ -0,0 +1,128 @@
+#include "functions.h"
+
+/*
+  Remote UI over Serial.
+
+  The LCD shadow in PackedLcd already knows which column spans changed, so a
+  typical point update costs one "D" line of ~30 bytes. Input bytes are turned
+  into encoder detents and virtual button presses that the FSM reads through
+  encoderCount() / buttonDown() next to the real hardware.
+*/
+
+#if REMOTE_UI
+
+static long          gRemoteEnc       = 0;      // injected detents
+static bool          gRemotePressed   = false;  // virtual button state
+static unsigned long gRemoteReleaseAt = 0;      // auto-release time for c / L (0 = host-timed)
+static bool          gLastBlink       = false;  // last blink state sent
+
+// Presses a timed virtual button (click / long press)
+static void remotePressFor(unsigned long ms) {
+    gRemotePressed   = true;
+    gRemoteReleaseAt = millis() + ms;
+    if (gRemoteReleaseAt == 0) {
+        gRemoteReleaseAt = 1;
+    }
+}
+
+void remoteUiInput() {
+    while (Serial.available() > 0) {
+        switch (Serial.read()) {
+        case '+': gRemoteEnc++;                               break;
+        case '-': gRemoteEnc--;                               break;
+        case 'c': remotePressFor(REMOTE_CLICK_MS);            break;
+        case 'L': remotePressFor(LONG_PRESS_MS + REMOTE_CLICK_MS); break;
+        case 'p': gRemotePressed = true;  gRemoteReleaseAt = 0; break;
+        case 'r': gRemotePressed = false; gRemoteReleaseAt = 0; break;
+        case 's': lcd.markAllDirty();                         break;
+        default:                                              break; // ignore newlines etc.
+        }
+    }
+
+    if (gRemotePressed && gRemoteReleaseAt != 0 && (long)(millis() - gRemoteReleaseAt) >= 0) {
+        gRemotePressed   = false;
+        gRemoteReleaseAt = 0;
+    }
+}
+
+/*
+  remoteUiOutput():
+  Sends at most what fits in the TX buffer right now. A row's span is only
+  marked clean after it has been written, so nothing is lost when the buffer
+  is full; it simply goes out on a later pass.
+*/
+void remoteUiOutput() {
+    if (Serial.availableForWrite() < 2) {
+        return;
+    }
+    if (lcd.takeCleared()) {
+        Serial.write((const uint8_t*)"Z\n", 2); // precedes the spans written after the clear
+    }
+
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+        uint8_t lo, hi;
+        if (!lcd.dirtySpan(row, lo, hi)) {
+            continue;
+        }
+        uint8_t len = hi - lo + 1;
+        if (Serial.availableForWrite() < len + 8) {
+            return;
+        }
+
+        char head[8];
+        uint8_t n = 0;
+        head[n++] = 'D';
+        head[n++] = '0' + row;
+        head[n++] = ',';
+        if (lo >= 10) head[n++] = '0' + lo / 10;
+        head[n++] = '0' + lo % 10;
+        head[n++] = ',';
+        Serial.write((const uint8_t*)head, n);
+        Serial.write((const uint8_t*)lcd.shadowRow(row) + lo, len);
+        Serial.write('\n');
+        lcd.clearDirty(row);
+    }
+
+    bool blink = lcd.blinking();
+    if ((blink || blink != gLastBlink) && Serial.availableForWrite() >= 10 && lcd.takeCursorChanged()) {
+        Serial.print('K');
+        Serial.print(lcd.cursorCol());
+        Serial.print(',');
+        Serial.print(lcd.cursorRow());
+        Serial.print(',');
+        Serial.print(blink ? 1 : 0);
+        Serial.print('\n');
+        gLastBlink = blink;
+    }
+}
+
+void remoteUiService() {
+    remoteUiInput();
+    remoteUiOutput();
+}
+
+long remoteEncoderOffset() {
+    return gRemoteEnc;
+}
+
+bool remoteButtonDown() {
+    return gRemotePressed;
+}
+
+#else  // REMOTE_UI disabled
+
+void remoteUiService() {}
+
+void remoteUiInput() {}
+
+void remoteUiOutput() {}
+
+long remoteEncoderOffset() {
+    return 0;
+}
+
+bool remoteButtonDown() {
+    return false;
+}
+
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Serial mirror of the LCD plus virtual encoder/button input.
+ *
+ * Device -> host (one line each, only when something changed):
+ *   Z                       screen cleared
+ *   D<row>,<col>,<text>     text of a changed column span
+ *   K<col>,<row>,<blink>    cursor position / blink (sent while blinking)
+ *
+ * Host -> device (single characters):
+ *   +  -   encoder one detent clockwise / counter-clockwise
+ *   c      click (short press)
+ *   L      long press
+ *   p  r   press / release (host-timed)
+ *   s      resync: resend the whole screen
+ *
+ * Output is only written when the Serial TX buffer has room for the whole
+ * line, so mirroring never blocks the loop; pending changes are kept in the
+ * LCD shadow until they fit. Tools/remoteTerm.cpp renders the mirror on a PC.
+ */
+
+/**
+ * @brief Processes received input and sends pending screen changes.
+ * Call every loop pass.
+ */
+void remoteUiService();
+
+/**
+ * @brief Input half of remoteUiService(): received keys and the virtual
+ * button's auto-release. Cheap; call every loop pass so remote presses keep
+ * their length while the axes are busy.
+ */
+void remoteUiInput();
+
+/**
+ * @brief Output half of remoteUiService(): pending screen changes.
+ */
+void remoteUiOutput();
+
+/**
+ * @brief Encoder detents injected by the host (added to the real count).
+ */
+long remoteEncoderOffset();
+
+/**
+ * @brief True while the host holds the virtual button down.
+ */
+bool remoteButtonDown();
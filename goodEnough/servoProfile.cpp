@@ -0,0 +1,78 @@
+#include "servoProfile.h"
+
+// Angle -> pulse mapping used by Servo::write() for the default attach()
+#ifndef MIN_PULSE_WIDTH
+#define MIN_PULSE_WIDTH 544
+#endif
+#ifndef MAX_PULSE_WIDTH
+#define MAX_PULSE_WIDTH 2400
+#endif
+
+ServoProfile::ServoProfile(float maxVel, float accel)
+    : _servo(0), _maxVel(maxVel), _accel(accel),
+      _from(90), _to(90), _angle(90), _startUs(0), _doneMs(0),
+      _moving(false), _lastUs(-1) {
+    _profile = profilePlan(0, maxVel, accel);
+}
+
+void ServoProfile::begin(Servo& servo, float angle) {
+    _servo  = &servo;
+    _from   = angle;
+    _to     = angle;
+    _moving = false;
+    _doneMs = millis();
+    _lastUs = -1;
+    writeAngle(angle);
+}
+
+void ServoProfile::moveTo(float angle) {
+    angle = constrain(angle, 0, 180);
+    if (angle == _to && !_moving) {
+        return;
+    }
+    _from    = _angle;
+    _to      = angle;
+    _profile = profilePlan(_to - _from, _maxVel, _accel);
+    _startUs = micros();
+    _moving  = true;
+}
+
+/*
+  update():
+  Evaluates the profile at the elapsed time and writes the command only when
+  the pulse width actually changes (1 us ~ 0.1 deg).
+*/
+void ServoProfile::update() {
+    if (!_moving) {
+        return;
+    }
+
+    float t = (micros() - _startUs) * 1e-6f;
+    if (t >= _profile.totalTime) {
+        _moving = false;
+        _doneMs = millis();
+        writeAngle(_to);
+        return;
+    }
+
+    float s = profilePosition(_profile, t);
+    writeAngle(_to >= _from ? _from + s : _from - s);
+}
+
+bool ServoProfile::settled(unsigned long settleMs) const {
+    return !_moving && (millis() - _doneMs) >= settleMs;
+}
+
+unsigned long ServoProfile::travelMs(float from, float to) const {
+    TrapezoidProfile p = profilePlan(to - from, _maxVel, _accel);
+    return (unsigned long)ceil(p.totalTime * 1000.0f);
+}
+
+void ServoProfile::writeAngle(float angle) {
+    _angle = angle;
+    int us = MIN_PULSE_WIDTH + (int)(angle * (MAX_PULSE_WIDTH - MIN_PULSE_WIDTH) / 180.0f + 0.5f);
+    if (us != _lastUs && _servo) {
+        _servo->writeMicroseconds(us);
+        _lastUs = us;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Servo.h>
+#include "profile.h"
+
+/**
+ * @brief Velocity/acceleration-limited angle trajectories for a hobby servo.
+ *
+ * servo.write() jumps the command, so the horn slams into the new angle at
+ * the servo's full speed and bounces. ServoProfile instead ramps the command
+ * along a trapezoidal profile (evaluated in closed form from the move start
+ * time, so the arrival time is known up front) and writes it with
+ * microsecond resolution. Call update() every loop.
+ *
+ * Moves always start from rest at the current commanded angle; a moveTo()
+ * issued mid-move restarts the profile from where the command is.
+ */
+class ServoProfile {
+public:
+    /**
+     * @param maxVel Angular speed limit (deg/s); keep below the servo's own speed.
+     * @param accel  Angular acceleration limit (deg/s^2).
+     */
+    ServoProfile(float maxVel, float accel);
+
+    /**
+     * @brief Binds the (already attached) servo and sets the start angle without a ramp.
+     */
+    void begin(Servo& servo, float angle);
+
+    /**
+     * @brief Starts a profiled move to angle (degrees, clamped to 0..180).
+     */
+    void moveTo(float angle);
+
+    /**
+     * @brief Advances the command. Call every loop pass.
+     */
+    void update();
+
+    /**
+     * @brief True once the command has reached the target.
+     */
+    bool done() const { return !_moving; }
+
+    /**
+     * @brief True once the command has been at the target for settleMs.
+     */
+    bool settled(unsigned long settleMs) const;
+
+    /**
+     * @brief Target angle of the current (or last) move.
+     */
+    float target() const { return _to; }
+
+    /**
+     * @brief Duration (ms) of a rest-to-rest move between two angles.
+     */
+    unsigned long travelMs(float from, float to) const;
+
+private:
+    void writeAngle(float angle);
+
+    Servo*           _servo;
+    float            _maxVel;
+    float            _accel;
+    float            _from;
+    float            _to;
+    float            _angle;
+    TrapezoidProfile _profile;
+    unsigned long    _startUs;
+    unsigned long    _doneMs;
+    bool             _moving;
+    int              _lastUs;
+};
@@ -0,0 +1,79 @@
+#include "shapedAxis.h"
+
+ShapedAxis::ShapedAxis(AccelStepper& m1, AccelStepper* m2)
+    : _motors(m2 ? 2 : 1), _start(0), _target(0), _ref(0), _t0(0), _active(false) {
+    _m[0]   = &m1;
+    _m[1]   = m2;
+    _shaper = shaperDesign(SHAPER_NONE, 0, 0);
+    _profile = profilePlan(0, 1, 1);
+}
+
+void ShapedAxis::configure(uint8_t type, float freqHz, float zeta) {
+    _shaper = shaperDesign(type, freqHz, zeta);
+}
+
+void ShapedAxis::moveTo(long target) {
+    _start   = _m[0]->currentPosition();
+    _target  = target;
+    _ref     = _start;
+    _profile = profilePlan((float)(target - _start), _m[0]->maxSpeed(), _m[0]->acceleration());
+    _t0      = micros();
+    _active  = (target != _start);
+    follow(_start);
+}
+
+/*
+  run():
+  Evaluates the shaped reference and retargets the motors when it moves to a
+  new whole step; motionService() steps them toward it. Finished once the
+  reference has reached the target and every motor is on it.
+*/
+bool ShapedAxis::run() {
+    if (!_active) {
+        return false;
+    }
+
+    float t = (micros() - _t0) * 1e-6f;
+    long ref;
+    if (t >= _profile.totalTime + _shaper.duration()) {
+        ref = _target;
+    } else {
+        float s = shapedPosition(_profile, _shaper, t);
+        ref = _start + (_target >= _start ? (long)(s + 0.5f) : -(long)(s + 0.5f));
+    }
+    if (ref != _ref) {
+        follow(ref);
+    }
+
+    bool moving = false;
+    for (uint8_t i = 0; i < _motors; i++) {
+        if (_m[i]->distanceToGo() != 0) {
+            moving = true;
+        }
+    }
+
+    if (!moving && ref == _target) {
+        _active = false;
+        for (uint8_t i = 0; i < _motors; i++) {
+            _m[i]->setSpeed(0);
+        }
+    }
+    return _active;
+}
+
+unsigned long ShapedAxis::remainingMs() const {
+    if (!_active) {
+        return 0;
+    }
+    float left = _profile.totalTime + _shaper.duration() - (micros() - _t0) * 1e-6f;
+    return left > 0 ? (unsigned long)(left * 1000.0f) + 1 : 0;
+}
+
+// moveTo() recomputes AccelStepper's ramp speed, so the follow speed is set after it
+void ShapedAxis::follow(long ref) {
+    _ref = ref;
+    for (uint8_t i = 0; i < _motors; i++) {
+        _m[i]->moveTo(ref);
+        _m[i]->setSpeed(_m[i]->maxSpeed());
+    }
+}
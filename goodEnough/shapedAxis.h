@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Arduino.h>
+#include <AccelStepper.h>
+#include "inputShaper.h"
+
+/**
+ * @brief Point-to-point moves with an input shaper on one logical axis.
+ *
+ * The unshaped trapezoid (from the first motor's maxSpeed()/acceleration())
+ * and the shaper are both known in closed form, so the shaped reference
+ * position is evaluated directly from the elapsed time; no history buffer is
+ * needed. The motors follow the reference at up to maxSpeed() in follow
+ * mode (runSpeedToPosition(), stepped by motionService()), which keeps them
+ * within a step of it because the shaped speed never exceeds the unshaped
+ * peak.
+ *
+ * Several motors can share one axis (the two X gantry motors).
+ */
+class ShapedAxis {
+public:
+    ShapedAxis(AccelStepper& m1, AccelStepper* m2 = 0);
+
+    /**
+     * @brief Sets the shaper (SHAPER_NONE / SHAPER_ZV / SHAPER_ZVD).
+     */
+    void configure(uint8_t type, float freqHz, float zeta);
+
+    /**
+     * @brief True if a shaper other than pass-through is configured.
+     */
+    bool enabled() const { return _shaper.count > 1; }
+
+    /**
+     * @brief Starts a shaped move from the current position to target.
+     */
+    void moveTo(long target);
+
+    /**
+     * @brief Advances the reference. Call every loop pass.
+     * @return true while the move is in progress.
+     */
+    bool run();
+
+    /**
+     * @brief True while a shaped move is in progress.
+     */
+    bool active() const { return _active; }
+
+    /**
+     * @brief Target of the current (or last) move.
+     */
+    long target() const { return _target; }
+
+    /**
+     * @brief Time (ms) until the shaped reference reaches the target.
+     */
+    unsigned long remainingMs() const;
+
+private:
+    void follow(long ref);
+
+    AccelStepper*    _m[2];
+    uint8_t          _motors;
+    InputShaper      _shaper;
+    TrapezoidProfile _profile;
+    long             _start;
+    long             _target;
+    long             _ref;
+    unsigned long    _t0;
+    bool             _active;
+};
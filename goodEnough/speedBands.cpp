@@ -0,0 +1,96 @@
+#include "functions.h"
+
+/*
+  Resonance speed-band avoidance.
+
+  Planning (bandCruiseSpeed): a move whose peak speed would land inside a band
+  is capped at the band's lower edge, so it never cruises there.
+
+  Execution (bandServiceAccel): a move whose cruise speed is above a band has
+  to ramp through it. While accelerating inside the band the motor gets
+  BAND_ACCEL_FACTOR times its acceleration; AccelStepper::setAcceleration()
+  rescales its step counter so the speed is continuous across the switch.
+  Since the peak was planned with normalAccel, the shorter ramp only leaves
+  more distance for the (normal) deceleration.
+
+  Straight-line moves (bandLineLimits): both axes' speeds are shares of one
+  path speed, so when a share lands in a band both drop together. Each pass
+  puts at least one axis on a band edge or its peak, so it ends after a few
+  passes; a move whose shares are left alone ends at once.
+*/
+
+#ifdef X_SPEED_BANDS
+static const SpeedBand kBandsX[] = X_SPEED_BANDS;
+#define X_BAND_COUNT (sizeof(kBandsX) / sizeof(kBandsX[0]))
+#else
+static const SpeedBand* const kBandsX = 0;
+#define X_BAND_COUNT 0
+#endif
+
+#ifdef Y_SPEED_BANDS
+static const SpeedBand kBandsY[] = Y_SPEED_BANDS;
+#define Y_BAND_COUNT (sizeof(kBandsY) / sizeof(kBandsY[0]))
+#else
+static const SpeedBand* const kBandsY = 0;
+#define Y_BAND_COUNT 0
+#endif
+
+static void axisBands(uint8_t axis, const SpeedBand*& bands, uint8_t& count) {
+    if (axis == BAND_AXIS_X) {
+        bands = kBandsX;
+        count = X_BAND_COUNT;
+    } else {
+        bands = kBandsY;
+        count = Y_BAND_COUNT;
+    }
+}
+
+float bandCruiseSpeed(uint8_t axis, long distance, float maxVel, float accel) {
+    const SpeedBand* bands;
+    uint8_t count;
+    axisBands(axis, bands, count);
+    if (count == 0) {
+        return maxVel;
+    }
+    return profileBandCruise((float)distance, maxVel, accel, bands, count);
+}
+
+void bandLineLimits(long dx, long dy, float& vx, float& vy, float& ax, float& ay) {
+    profileLineLimits((float)dx, (float)dy, vx, vy, ax, ay);
+    for (;;) {
+        float kx = dx != 0 ? bandCruiseSpeed(BAND_AXIS_X, dx, vx, ax) / vx : 1;
+        float ky = dy != 0 ? bandCruiseSpeed(BAND_AXIS_Y, dy, vy, ay) / vy : 1;
+        float k  = min(kx, ky);
+        if (k > 0.999f) {
+            return;
+        }
+        vx *= k;
+        vy *= k;
+    }
+}
+
+void bandServiceAccel(AccelStepper& m, uint8_t axis, float normalAccel) {
+    const SpeedBand* bands;
+    uint8_t count;
+    axisBands(axis, bands, count);
+    if (count == 0) {
+        return;
+    }
+
+    float v = fabs(m.speed());
+    bool inBand = false;
+    for (uint8_t i = 0; i < count; i++) {
+        if (v > bands[i].lo && v < bands[i].hi) {
+            inBand = true;
+            break;
+        }
+    }
+
+    // Braking distance at normal acceleration reached -> this is the ramp down
+    bool braking = (v * v / (2.0 * normalAccel)) >= labs(m.distanceToGo());
+
+    float want = (inBand && !braking) ? normalAccel * BAND_ACCEL_FACTOR : normalAccel;
+    if (m.acceleration() != want) {
+        m.setAcceleration(want);
+    }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+#include <AccelStepper.h>
+
+// Axis selectors for the band tables (X_SPEED_BANDS / Y_SPEED_BANDS)
+#define BAND_AXIS_X 0
+#define BAND_AXIS_Y 1
+
+/**
+ * @brief Max speed to use for a move of distance steps so that it never
+ * cruises inside one of the axis' resonance bands.
+ */
+float bandCruiseSpeed(uint8_t axis, long distance, float maxVel, float accel);
+
+/**
+ * @brief Limits for a two-axis move of (dx, dy) that stays on its straight
+ * line (profileLineLimits()) and does not cruise inside a band on either
+ * axis. vx / vy / ax / ay are the axes' own limits on entry.
+ */
+void bandLineLimits(long dx, long dy, float& vx, float& vy, float& ax, float& ay);
+
+/**
+ * @brief Raises the acceleration of a running motor while it accelerates
+ * through a resonance band, and restores normalAccel outside the band.
+ *
+ * Call next to run(). Deceleration keeps normalAccel: AccelStepper decides
+ * when to start braking from the current acceleration, so raising it on the
+ * way down would make it re-accelerate.
+ */
+void bandServiceAccel(AccelStepper& m, uint8_t axis, float normalAccel);
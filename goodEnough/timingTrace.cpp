@@ -0,0 +1,184 @@
+#include "functions.h"
+
+/*
+  Timing trace (format in timingTrace.h).
+
+  Only one move per axis can be pending, which matches the auto sequencer:
+  an axis is never recommanded before runAxisX() / runAxisY() has reported
+  its arrival. The arrival is timed at once but printed from traceService()
+  when no axis is busy; a move commanded while its axis' last line still
+  waits is not traced.
+*/
+
+#ifdef TIMING_TRACE
+
+static bool          gTraceRun     = false;
+static unsigned long gRunStart     = 0;
+
+// Pending move per axis (0 = X, 1 = Y)
+static bool          gMovePending[2] = { false, false };
+static long          gMoveSteps[2];
+static float         gMoveVel[2];
+static float         gMoveAccel[2];
+static unsigned long gMoveStart[2];
+static bool          gMoveDone[2] = { false, false };  // arrived, TM line not printed yet
+static unsigned long gMoveUs[2];
+static unsigned long gMoveGapUs[2];
+
+// Loop pass statistics
+static unsigned long gLastPass     = 0;
+static unsigned long gMaxGap       = 0;   // whole run
+static unsigned long gMoveGap      = 0;   // since the last traced move command
+static unsigned long gGapSum       = 0;
+static unsigned long gPasses       = 0;
+
+// Probe move in progress
+static bool          gServoPending = false;
+static float         gServoFrom    = 0;
+static float         gServoTo      = 0;
+static unsigned long gServoStart   = 0;
+
+void traceRunStart(const char* name) {
+    gTraceRun = true;
+    gRunStart = micros();
+    gLastPass = gRunStart;
+    gMaxGap   = 0;
+    gMoveGap  = 0;
+    gGapSum   = 0;
+    gPasses   = 0;
+    gMovePending[0] = gMovePending[1] = false;
+    gMoveDone[0]    = gMoveDone[1]    = false;
+    gServoTo      = probe.target();
+    gServoPending = false;
+
+    Serial.print("TJ,");
+    Serial.println(name);
+}
+
+static void printMove(uint8_t i) {
+    gMoveDone[i] = false;
+
+    Serial.print("TM,");
+    Serial.print(i ? 'Y' : 'X');
+    Serial.print(',');
+    Serial.print(gMoveSteps[i]);
+    Serial.print(',');
+    Serial.print(gMoveVel[i], 0);
+    Serial.print(',');
+    Serial.print(gMoveAccel[i], 0);
+    Serial.print(',');
+    Serial.print(gMoveUs[i]);
+    Serial.print(',');
+    Serial.println(gMoveGapUs[i]);
+}
+
+void traceRunEnd() {
+    if (!gTraceRun) {
+        return;
+    }
+    gTraceRun = false;
+    for (uint8_t i = 0; i < 2; i++) {
+        if (gMoveDone[i]) {
+            printMove(i);
+        }
+    }
+
+    Serial.print("TE,");
+    Serial.print(micros() - gRunStart);
+    Serial.print(',');
+    Serial.print(gMaxGap);
+    Serial.print(',');
+    Serial.println(gPasses ? gGapSum / gPasses : 0);
+}
+
+void traceMoveStart(char axis, long steps, float maxVel, float accel) {
+    uint8_t i = (axis == 'Y');
+    if (!gTraceRun || steps == 0 || gMoveDone[i]) {
+        return;
+    }
+    gMovePending[i] = true;
+    gMoveSteps[i]   = steps;
+    gMoveVel[i]     = maxVel;
+    gMoveAccel[i]   = accel;
+    gMoveStart[i]   = micros();
+    gMoveGap        = 0;
+}
+
+void traceMoveEnd(char axis) {
+    uint8_t i = (axis == 'Y');
+    if (!gMovePending[i]) {
+        return;
+    }
+    gMovePending[i] = false;
+    gMoveDone[i]    = true;
+    gMoveUs[i]      = micros() - gMoveStart[i];
+    gMoveGapUs[i]   = gMoveGap;
+}
+
+void traceLcd(uint8_t bytes, unsigned long us) {
+    if (!gTraceRun) {
+        return;
+    }
+    Serial.print("TL,");
+    Serial.print(bytes);
+    Serial.print(',');
+    Serial.println(us);
+}
+
+/*
+  traceService():
+  A probe move starts when the profile target changes and ends when the
+  profile reports done(); the settle dwell is not part of it. Arrived moves
+  are printed here once every axis is at rest.
+*/
+void traceService() {
+    if (!gTraceRun) {
+        return;
+    }
+
+    unsigned long now = micros();
+    unsigned long gap = now - gLastPass;
+    gLastPass = now;
+    if (gap > gMaxGap)  gMaxGap  = gap;
+    if (gap > gMoveGap) gMoveGap = gap;
+    gGapSum += gap;
+    gPasses++;
+
+    if (!gServoPending && probe.target() != gServoTo) {
+        gServoFrom    = gServoTo;
+        gServoTo      = probe.target();
+        gServoStart   = now;
+        gServoPending = true;
+    }
+    if (gServoPending && probe.done()) {
+        gServoPending = false;
+
+        Serial.print("TS,");
+        Serial.print(gServoFrom, 0);
+        Serial.print(',');
+        Serial.print(gServoTo, 0);
+        Serial.print(',');
+        Serial.print(now - gServoStart);
+        Serial.print(',');
+        Serial.println(probe.travelMs(gServoFrom, gServoTo));
+    }
+
+    if ((gMoveDone[0] || gMoveDone[1]) && !motionBusy(MOTION_ALL)) {
+        for (uint8_t i = 0; i < 2; i++) {
+            if (gMoveDone[i]) {
+                printMove(i);
+            }
+        }
+    }
+}
+
+#else  // TIMING_TRACE disabled
+
+void traceRunStart(const char*) {}
+void traceRunEnd() {}
+void traceMoveStart(char, long, float, float) {}
+void traceMoveEnd(char) {}
+void traceLcd(uint8_t, unsigned long) {}
+void traceService() {}
+
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief On-device timing trace for calibrating the host simulator.
+ *
+ * With TIMING_TRACE defined (functions.h) every auto run prints one line per
+ * event to Serial; tools/traceFit.cpp fits the simulator's models to them:
+ *   TJ,<name>                                    run start (job name or GRID / STITCH)
+ *   TM,<axis>,<steps>,<maxVel>,<accel>,<us>,<gapUs>
+ *                                                plain travel move, command to arrival,
+ *                                                with the longest loop pass during it
+ *   TS,<fromDeg>,<toDeg>,<us>,<profileMs>        probe move, command to profile end,
+ *                                                and the profile's own travel time
+ *   TL,<bytes>,<us>                              LCD row write, expander bytes and time
+ *   TE,<us>,<maxGapUs>,<meanGapUs>               run end: wall time and loop pass stats
+ *
+ * Lines are printed between moves, never from the step path: a TM line
+ * waits until no axis has motion pending, so it never holds the other axis
+ * of a two-axis move. A full TX buffer still blocks for a few ms; run
+ * calibration captures with REMOTE_UI 0. Shaped, routed and coarse
+ * (MICROSTEP_PIN) moves are not traced (their time is not a plain trapezoid
+ * at the logged limits).
+ * Without TIMING_TRACE all calls are empty.
+ */
+
+/**
+ * @brief Starts a traced run (also resets the loop statistics).
+ */
+void traceRunStart(const char* name);
+
+/**
+ * @brief Ends the current run (no-op if none is active).
+ */
+void traceRunEnd();
+
+/**
+ * @brief Marks the command of a plain move on axis 'X' or 'Y'.
+ */
+void traceMoveStart(char axis, long steps, float maxVel, float accel);
+
+/**
+ * @brief Marks the arrival of the axis; only the first call after
+ * traceMoveStart() counts. The TM line follows from traceService().
+ */
+void traceMoveEnd(char axis);
+
+/**
+ * @brief Records one LCD write of the given expander byte count.
+ */
+void traceLcd(uint8_t bytes, unsigned long us);
+
+/**
+ * @brief Loop pass timing, probe move detection and the TM lines of
+ * arrived moves once every axis is at rest. Call every loop pass.
+ */
+void traceService();
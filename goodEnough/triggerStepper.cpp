@@ -0,0 +1,58 @@
+#include "triggerStepper.h"
+
+TriggerStepper::TriggerStepper(uint8_t interface, uint8_t stepPin, uint8_t dirPin)
+    : AccelStepper(interface, stepPin, dirPin),
+      _triggers(0), _trigCount(0), _trigIndex(0), _trigPin(0xff),
+      _pulseUs(0), _pulseActive(false), _pulseStart(0) {}
+
+void TriggerStepper::loadTriggers(const long* positions, uint8_t count, uint8_t outPin, unsigned int pulseUs) {
+    clearTriggers();
+    _trigPin   = outPin;
+    _pulseUs   = pulseUs;
+    pinMode(_trigPin, OUTPUT);
+    digitalWrite(_trigPin, LOW);
+    _triggers  = positions;
+    _trigCount = count;
+}
+
+void TriggerStepper::clearTriggers() {
+    if (_pulseActive) {
+        digitalWrite(_trigPin, LOW);
+        _pulseActive = false;
+    }
+    _triggers  = 0;
+    _trigCount = 0;
+    _trigIndex = 0;
+}
+
+void TriggerStepper::serviceTriggers() {
+    if (_pulseActive && (micros() - _pulseStart) >= _pulseUs) {
+        digitalWrite(_trigPin, LOW);
+        _pulseActive = false;
+    }
+}
+
+/*
+  step():
+  Called by AccelStepper after _currentPos has been updated for this step.
+  A trigger counts as crossed once the position reaches or passes it in the
+  current direction, so a missed exact match (e.g. position changed by
+  setCurrentPosition) still fires instead of stalling the list.
+*/
+void TriggerStepper::step(long step) {
+    AccelStepper::step(step);
+
+    if (_trigIndex >= _trigCount) {
+        return;
+    }
+
+    long pos  = currentPosition();
+    long trig = _triggers[_trigIndex];
+    bool crossed = (_direction == DIRECTION_CW) ? (pos >= trig) : (pos <= trig);
+    if (crossed) {
+        digitalWrite(_trigPin, HIGH);
+        _pulseStart  = micros();
+        _pulseActive = true;
+        _trigIndex++;
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Arduino.h>
+#include <AccelStepper.h>
+
+/**
+ * @brief AccelStepper that fires an output when the axis crosses preloaded
+ * step positions.
+ *
+ * The check runs inside step(), i.e. right after AccelStepper emits the step
+ * pulse that reaches the position, so trigger latency is below one step
+ * interval regardless of what else the loop is doing. The pulse is ended by
+ * serviceTriggers(), which must be called alongside run().
+ */
+class TriggerStepper : public AccelStepper {
+public:
+    TriggerStepper(uint8_t interface, uint8_t stepPin, uint8_t dirPin);
+
+    /**
+     * @brief Arms a list of trigger positions (absolute steps).
+     * @param positions Sorted in the direction of travel; the array must stay
+     *        valid until the list is finished or cleared (it is not copied).
+     * @param count     Number of entries in positions.
+     * @param outPin    Output pulsed HIGH for pulseUs at each crossing.
+     * @param pulseUs   Pulse width in microseconds.
+     */
+    void loadTriggers(const long* positions, uint8_t count, uint8_t outPin, unsigned int pulseUs);
+
+    /**
+     * @brief Disarms any remaining triggers and drops the output.
+     */
+    void clearTriggers();
+
+    /**
+     * @brief Ends the current output pulse once its width has elapsed.
+     */
+    void serviceTriggers();
+
+    /**
+     * @brief Number of triggers fired since loadTriggers().
+     */
+    uint8_t triggersFired() const { return _trigIndex; }
+
+    /**
+     * @brief True when every loaded trigger has fired and the pulse is over.
+     */
+    bool triggersDone() const { return _trigIndex >= _trigCount && !_pulseActive; }
+
+protected:
+    virtual void step(long step);
+
+private:
+    const long*   _triggers;
+    uint8_t       _trigCount;
+    uint8_t       _trigIndex;
+    uint8_t       _trigPin;
+    unsigned int  _pulseUs;
+    bool          _pulseActive;
+    unsigned long _pulseStart;
+};
@@ -0,0 +1,148 @@
+#include "functions.h"
+#include <avr/io.h>
+#include <avr/wdt.h>
+
+/*
+  Warm restart state (see warmStart.h).
+
+  Every update rewrites the checksum last, so a reset in the middle of one
+  leaves a state that fails the check and starts cold. The reset flags are
+  read in .init3, before the C runtime and before a watchdog left running
+  by the reset (shortest timeout) can fire again.
+*/
+
+#define WARM_MAGIC 0x57a3
+
+#define WARM_AT_REST 0x01   // positions below are valid
+#define WARM_HOMED   0x02
+#define WARM_RUN     0x04   // job / point below are valid
+#define WARM_POWERED 0x08   // drivers enabled (holding their step)
+
+struct WarmState {
+    uint16_t magic;
+    uint8_t  flags;
+    uint8_t  job;
+    uint16_t point;
+    long     x1;
+    long     x2;
+    long     y;
+    uint16_t sum;   // Fletcher-16 of everything above
+};
+
+static WarmState gWarm       __attribute__((section(".noinit")));
+static uint8_t   gResetFlags __attribute__((section(".noinit")));
+
+void warmEarly() __attribute__((naked, used, section(".init3")));
+void warmEarly() {
+    gResetFlags = MCUSR;
+    MCUSR = 0;
+    wdt_disable();
+}
+
+static uint16_t warmSum() {
+    const uint8_t* p = (const uint8_t*)&gWarm;
+    uint8_t a = 0, b = 0;
+    for (uint8_t i = 0; i < offsetof(WarmState, sum); i++) {
+        a = (uint8_t)((a + p[i]) % 255);
+        b = (uint8_t)((b + a) % 255);
+    }
+    return ((uint16_t)b << 8) | a;
+}
+
+static void seal() {
+    gWarm.sum = warmSum();
+}
+
+static void storePositions() {
+    gWarm.x1 = motorX1.currentPosition();
+    gWarm.x2 = motorX2.currentPosition();
+    gWarm.y  = motorY.currentPosition();
+    gWarm.flags |= WARM_AT_REST;
+}
+
+bool warmRestore() {
+    bool cold = (gResetFlags & (_BV(PORF) | _BV(BORF))) != 0;
+    uint8_t need = WARM_AT_REST | WARM_HOMED | WARM_POWERED;
+    bool ok   = !cold && gWarm.magic == WARM_MAGIC && gWarm.sum == warmSum() &&
+                (gWarm.flags & need) == need;
+
+    if (ok) {
+        motorX1.setCurrentPosition(gWarm.x1);
+        motorX2.setCurrentPosition(gWarm.x2);
+        motorY.setCurrentPosition(gWarm.y);
+    } else {
+        gWarm.magic = WARM_MAGIC;
+        gWarm.flags = WARM_POWERED;   // setup() enables the drivers
+        gWarm.job   = 0;
+        gWarm.point = 0;
+        storePositions();
+        seal();
+    }
+
+#ifdef WATCHDOG
+    wdt_enable(WATCHDOG);
+#endif
+    return ok;
+}
+
+void warmService() {
+    warmKick();
+
+    // An axis may have been pushed while its driver was off
+    bool powered = motionEnabled();
+    if (powered != ((gWarm.flags & WARM_POWERED) != 0)) {
+        gWarm.flags ^= WARM_POWERED;
+        seal();
+    }
+
+    bool busy = motionBusy(MOTION_ALL);
+    if (busy == !(gWarm.flags & WARM_AT_REST)) {
+        return;
+    }
+    if (busy) {
+        gWarm.flags &= ~WARM_AT_REST;   // before the first step of the move
+    } else {
+        storePositions();
+    }
+    seal();
+}
+
+void warmKick() {
+#ifdef WATCHDOG
+    wdt_reset();
+#endif
+}
+
+void warmSetHomed(bool homed) {
+    if (homed) {
+        gWarm.flags |= WARM_HOMED;
+        storePositions();
+    } else {
+        gWarm.flags &= ~(WARM_HOMED | WARM_AT_REST);
+    }
+    seal();
+}
+
+bool warmHomed() {
+    return (gWarm.flags & WARM_HOMED) != 0;
+}
+
+void warmSetRunPoint(uint8_t job, uint16_t idx) {
+    gWarm.flags |= WARM_RUN;
+    gWarm.job   = job;
+    gWarm.point = idx;
+    seal();
+}
+
+void warmClearRun() {
+    if (gWarm.flags & WARM_RUN) {
+        gWarm.flags &= ~WARM_RUN;
+        seal();
+    }
+}
+
+bool warmRunPoint(uint8_t& job, uint16_t& idx) {
+    job = gWarm.job;
+    idx = gWarm.point;
+    return (gWarm.flags & WARM_RUN) != 0;
+}
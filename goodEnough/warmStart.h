@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Warm restart: motion state kept across resets that are not a
+ * power-on.
+ *
+ * The axis positions, the homed flag and the auto-run point the machine is
+ * stopped at live in .noinit RAM (not cleared by the C runtime) with a
+ * checksum. Positions are only stored while every axis is at rest; a move
+ * marks them stale before its first step. After a watchdog, reset-button or
+ * software reset setup() calls warmRestore(): if the state is intact, homed,
+ * at rest and the drivers were enabled, the positions are put back and
+ * homing is skipped, and an interrupted auto run continues at its point. A
+ * power-on or brown-out reset (when the reset flags reach the sketch; the
+ * Uno bootloader may clear them), a reset mid-move or with the drivers
+ * powered down (motionIdleTimeout()), or a bad checksum starts cold.
+ *
+ * The drivers must stay powered through the reset: their step indexers
+ * keep the motor on the same step while ENABLE_PIN floats.
+ */
+
+/**
+ * @brief Restores the axis positions from a valid warm state. Call in
+ * setup() once the motors exist; on false, home as usual.
+ */
+bool warmRestore();
+
+/**
+ * @brief Keeps the stored positions current. Call every loop pass before
+ * motionService(); also feeds the watchdog.
+ */
+void warmService();
+
+/**
+ * @brief Feeds the watchdog (WATCHDOG only). For blocking loops.
+ */
+void warmKick();
+
+/**
+ * @brief Marks the axes homed (positions stored at once) or not homed.
+ */
+void warmSetHomed(bool homed);
+
+/**
+ * @brief True once autoHome() has finished (or a warm restart restored it).
+ */
+bool warmHomed();
+
+/**
+ * @brief Records the auto-run stop the machine is at (job JOB_NONE = grid).
+ */
+void warmSetRunPoint(uint8_t job, uint16_t idx);
+
+/**
+ * @brief Forgets the auto-run stop (run finished or left).
+ */
+void warmClearRun();
+
+/**
+ * @brief Auto-run stop recorded before the reset.
+ * @return false if no run was in progress.
+ */
+bool warmRunPoint(uint8_t& job, uint16_t& idx);
@@ -0,0 +1,65 @@
+#include "functions.h"
+
+/*
+  Work origin (see workOrigin.h).
+
+  EEPROM layout at ORIGIN_EEPROM_BASE: 'O', then the offset as two longs.
+*/
+
+static long gOriginX = 0;
+static long gOriginY = 0;
+
+static void originSave() {
+    EEPROM.update(ORIGIN_EEPROM_BASE, 0xff);   // invalid while the offset is rewritten
+    EEPROM.put(ORIGIN_EEPROM_BASE + 1, gOriginX);
+    EEPROM.put(ORIGIN_EEPROM_BASE + 5, gOriginY);
+    EEPROM.update(ORIGIN_EEPROM_BASE, 'O');   // marker last: a torn save loads as no origin
+}
+
+void originLoad() {
+    if (EEPROM.read(ORIGIN_EEPROM_BASE) != 'O') {
+        gOriginX = 0;
+        gOriginY = 0;
+        return;
+    }
+    EEPROM.get(ORIGIN_EEPROM_BASE + 1, gOriginX);
+    EEPROM.get(ORIGIN_EEPROM_BASE + 5, gOriginY);
+}
+
+// The axes sit at a corrected machine position; the offset is taken nominal
+void originSetHere() {
+    long nx = motorX1.currentPosition();
+    long ny = motorY.currentPosition();
+    correctionRemove(nx, ny);
+
+    long gx, gy;
+    autoGridPoint(0, gx, gy);
+    gOriginX = nx - gx;
+    gOriginY = ny - gy;
+    originSave();
+}
+
+void originClear() {
+    gOriginX = 0;
+    gOriginY = 0;
+    EEPROM.update(ORIGIN_EEPROM_BASE, 0xff);
+}
+
+long originX() {
+    return gOriginX;
+}
+
+long originY() {
+    return gOriginY;
+}
+
+void originApply(long& x, long& y) {
+    x += gOriginX;
+    y += gOriginY;
+}
+
+void originRemove(long& x, long& y) {
+    correctionRemove(x, y);
+    x -= gOriginX;
+    y -= gOriginY;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Work origin: where the part sits relative to the compile-time grid.
+ *
+ * The grid and stored jobs are written in work coordinates, which equal
+ * machine coordinates (relative to the homed zero) while no origin is set.
+ * Holding the button in a jog screen stores the jogged position as the
+ * place of the grid's first point; every auto-mode target is then shifted
+ * by that offset before the correction map is applied, so runs start right
+ * at the part. The offset is kept in EEPROM at ORIGIN_EEPROM_BASE.
+ */
+
+/**
+ * @brief Loads the offset from EEPROM (zero if none is stored).
+ */
+void originLoad();
+
+/**
+ * @brief Makes the current position (axes at rest) the grid's first point
+ * and stores the offset.
+ */
+void originSetHere();
+
+/**
+ * @brief Drops the offset (work coordinates = machine coordinates again).
+ */
+void originClear();
+
+/**
+ * @brief Current offset (steps).
+ */
+long originX();
+long originY();
+
+/**
+ * @brief Work coordinates -> nominal machine coordinates.
+ */
+void originApply(long& x, long& y);
+
+/**
+ * @brief Machine position -> work coordinates (correction and offset removed).
+ */
+void originRemove(long& x, long& y);
@@ -0,0 +1,164 @@
+/*
+  arcCheck: host check of the path planner's arc chords.
+
+  Runs the firmware's arc generator (goodEnough/arcGen.h, the Q30 rotation
+  with exact re-anchoring every ARC_CORRECTION chords) over a fixed set of
+  arcs: full circles and random sweeps in both directions, radii from a few
+  steps to the size of the machine, integer start and end points as a job
+  stores them. For every arc it checks that
+    - no chord strays more than ARC_TOLERANCE from the circle through the
+      start point (chord sagitta plus the rounding of its end points), and
+    - the last chord ends exactly on the programmed end point without a
+      jump: it is no longer than the nominal chord plus the rounding allowance.
+  The worst arc is printed; the exit status is non-zero on any failure.
+
+  Build and run from the repo root:
+      g++ -O2 -std=c++11 -o arcCheck tools/arcCheck.cpp && ./arcCheck [arcs]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../goodEnough/motionConfig.h"
+#include "../goodEnough/arcGen.h"
+
+struct ArcCase {
+    long sx, sy, x, y, cx, cy;
+    bool ccw;
+};
+
+struct ArcResult {
+    double   deviation;  // worst distance of a chord from the circle (steps)
+    double   lastChord;  // length of the closing chord (steps)
+    double   nominal;    // nominal chord length (steps)
+    uint16_t chords;
+    bool     closed;     // last point == programmed end point
+};
+
+static uint32_t gRng = 12345;
+
+static uint32_t nextRand() {
+    gRng ^= gRng << 13;
+    gRng ^= gRng >> 17;
+    gRng ^= gRng << 5;
+    return gRng;
+}
+
+// Uniform in [0, 1)
+static double randUnit() {
+    return (nextRand() >> 8) * (1.0 / 16777216.0);
+}
+
+// Largest distance of segment p-q from the circle of radius r around c
+static double chordDeviation(double px, double py, double qx, double qy, double r) {
+    double dx  = qx - px;
+    double dy  = qy - py;
+    double len = dx * dx + dy * dy;
+    double t   = len > 0 ? -(px * dx + py * dy) / len : 0;
+    if (t < 0) t = 0;
+    if (t > 1) t = 1;
+    double mx   = px + t * dx;
+    double my   = py + t * dy;
+    double in   = r - sqrt(mx * mx + my * my);
+    double outP = sqrt(px * px + py * py) - r;
+    double outQ = sqrt(qx * qx + qy * qy) - r;
+    double dev  = in;
+    if (outP > dev) dev = outP;
+    if (outQ > dev) dev = outQ;
+    return dev;
+}
+
+static ArcResult runArc(const ArcCase& c) {
+    ArcGen g;
+    arcBegin(g, c.sx, c.sy, c.x, c.y, c.cx, c.cy, c.ccw, ARC_TOLERANCE, ARC_CORRECTION);
+
+    double r = sqrt((double)(c.sx - c.cx) * (c.sx - c.cx) + (double)(c.sy - c.cy) * (c.sy - c.cy));
+
+    ArcResult res;
+    res.deviation = 0;
+    res.chords    = 0;
+    res.nominal   = 2 * r * sin(fabs(g.step) / 2);
+
+    long px = c.sx;
+    long py = c.sy;
+    long x  = px;
+    long y  = py;
+    while (g.active) {
+        arcNext(g, x, y);
+        res.chords++;
+        double d = chordDeviation(px - c.cx, py - c.cy, x - c.cx, y - c.cy, r);
+        if (d > res.deviation) {
+            res.deviation = d;
+        }
+        res.lastChord = sqrt((double)(x - px) * (x - px) + (double)(y - py) * (y - py));
+        px = x;
+        py = y;
+    }
+    res.closed = (x == c.x && y == c.y);
+    return res;
+}
+
+// Integer point at angle a on the circle of radius r around (cx, cy)
+static void circlePoint(long cx, long cy, double r, double a, long& x, long& y) {
+    x = cx + lround(r * cos(a));
+    y = cy + lround(r * sin(a));
+}
+
+int main(int argc, char** argv) {
+    int arcs = argc > 1 ? atoi(argv[1]) : 20000;
+
+    static const double radii[] = { 3, 5, 10, 37, 100, 500, 2000, 10000, 50000 };
+    const int nRadii = sizeof(radii) / sizeof(radii[0]);
+
+    double    worstDev = 0;
+    ArcCase   worstCase = {};
+    ArcResult worst = {};
+    long      failures = 0;
+    long      chords = 0;
+
+    for (int i = 0; i < arcs; i++) {
+        ArcCase c;
+        double  r = (i < 4 * nRadii) ? radii[i / 4] : radii[0] + randUnit() * (radii[nRadii - 1] - radii[0]);
+        c.cx  = (long)(randUnit() * 40000) - 20000;
+        c.cy  = (long)(randUnit() * 40000) - 20000;
+        c.ccw = (i & 1) != 0;
+
+        double a0 = randUnit() * 2 * M_PI;
+        circlePoint(c.cx, c.cy, r, a0, c.sx, c.sy);
+        if (i & 2) {
+            c.x = c.sx;   // full circle
+            c.y = c.sy;
+        } else {
+            double sweep = (0.01 + randUnit() * 1.99) * M_PI;
+            circlePoint(c.cx, c.cy, r, c.ccw ? a0 + sweep : a0 - sweep, c.x, c.y);
+        }
+
+        ArcResult res = runArc(c);
+        chords += res.chords;
+
+        bool bad = res.deviation > ARC_TOLERANCE || !res.closed ||
+                   res.lastChord > res.nominal + 2 * ARC_ROUND_ALLOWANCE;
+        if (bad) {
+            if (failures < 10) {
+                printf("FAIL r=%.0f (%ld,%ld)->(%ld,%ld) c=(%ld,%ld) %s: deviation %.3f, "
+                       "last chord %.2f of %.2f, %s\n",
+                       r, c.sx, c.sy, c.x, c.y, c.cx, c.cy, c.ccw ? "ccw" : "cw", res.deviation,
+                       res.lastChord, res.nominal, res.closed ? "closed" : "NOT CLOSED");
+            }
+            failures++;
+        }
+        if (res.deviation > worstDev) {
+            worstDev  = res.deviation;
+            worstCase = c;
+            worst     = res;
+        }
+    }
+
+    printf("%d arcs, %ld chords, tolerance %.2f steps, re-anchor every %d chords\n", arcs, chords,
+           (double)ARC_TOLERANCE, ARC_CORRECTION);
+    printf("Worst deviation %.3f steps (center %ld,%ld, %u chords)\n", worstDev, worstCase.cx,
+           worstCase.cy, worst.chords);
+    printf("%s: %ld failures\n", failures == 0 ? "PASS" : "FAIL", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,429 @@
+/*
+  batchSim: host batch simulator for comparing many variants of one job.
+
+  A variant is a visiting order of the job's points plus a motion tuning
+  (per-axis max speed and acceleration scale). Each variant runs as one
+  virtual machine. The machines are simulated in blocks of BLOCK lanes held
+  as structure-of-arrays (one array per quantity, one element per machine),
+  all advancing one move per kernel pass, so the inner loop is the same
+  arithmetic over contiguous lanes and the compiler vectorizes it (the
+  math flags below let it turn profilePlan()'s branches into selects; they
+  do not reorder arithmetic). Blocks are shared out to worker threads.
+
+  A move runs both axes at once, like startTravel() / motionTravel(): its
+  time is the longer of the two axis times. Per axis, the acceleration
+  comes from profileSelectAccel() and the time from profilePlan()
+  (goodEnough/profile.h). A calibration from traceFit (simModel.h) adds the
+  step-rate ceilings and per-move overheads, as in profileSim. Probe, dwell,
+  input shaping, resonance bands and keep-out routing are not modelled.
+
+  Variant 0 is the job as given with the configured tuning. Order variants
+  apply random segment reversals to the order (-m per variant). With
+  --tune, every odd variant is a tuning variant instead: the given order
+  with each axis' speed and accelerations scaled down by a random factor of
+  up to pct, never above the configured limits (e.g. to see how much a
+  gentler tuning costs). The fastest order and the fastest tuning are
+  reported separately; -o writes the points of the fastest order in run
+  order. --check runs every variant again through the scalar
+  single-machine path (simMoveTime()) and fails on any difference.
+
+  Points: "x y" lines in steps ('#' comments), or the compile-time grid
+  (gridPoint(), motionConfig.h) if no file is given.
+
+  Build and run from the repo root:
+      g++ -O3 -march=native -fno-math-errno -fno-trapping-math -fno-signed-zeros \
+          -ffinite-math-only -std=c++11 -pthread -o batchSim tools/batchSim.cpp
+      ./batchSim [-n variants] [-t threads] [-m reversals] [--tune pct] [--seed s]
+                 [-c simCal.txt] [-o best.txt] [--check] [points.txt]
+*/
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../goodEnough/motionConfig.h"
+#include "../goodEnough/profile.h"
+#include "simModel.h"
+
+#define BLOCK 128   // machines per structure-of-arrays block
+
+struct Tuning {
+    float maxVelX, accelX, shortAccelX;
+    float maxVelY, accelY, shortAccelY;
+};
+
+struct Result {
+    float    time;
+    uint32_t variant;
+};
+
+static SimModel           gModel = simModelNominal();
+static std::vector<float> gPx;   // job points, given order
+static std::vector<float> gPy;
+static uint32_t           gSeed      = 1;
+static int                gReversals = 2;
+static float              gTune      = 0;
+
+// ---------------- Variant generation ----------------
+
+// xorshift32: small, seedable per variant so any variant can be rebuilt alone
+static uint32_t nextRand(uint32_t& s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+// Never above 1: a variant must stay within the firmware's limits
+static float randScale(uint32_t& s) {
+    float u = (nextRand(s) & 0xffffff) / 16777216.0f;   // 0..1
+    return 1.0f - gTune * u;
+}
+
+// Tuning variant (given order, scaled limits) rather than an order variant
+static bool variantTunes(uint32_t v) {
+    return gTune > 0 && (v & 1);
+}
+
+/*
+  makeVariant():
+  Order and tuning of variant v, rebuilt from (seed, v) alone.
+*/
+static void makeVariant(uint32_t v, std::vector<uint32_t>& order, Tuning& tu) {
+    size_t n = gPx.size();
+    order.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        order[i] = (uint32_t)i;
+    }
+    tu.maxVelX     = X_MAX_SPEED;
+    tu.accelX      = X_ACCEL;
+    tu.shortAccelX = X_SHORT_ACCEL;
+    tu.maxVelY     = Y_MAX_SPEED;
+    tu.accelY      = Y_ACCEL;
+    tu.shortAccelY = Y_SHORT_ACCEL;
+    if (v == 0) {
+        return;
+    }
+    bool tuneOnly = variantTunes(v);
+
+    uint32_t s = gSeed * 2654435761u ^ (v * 40503u + 0x9e3779b9u);
+    if (s == 0) {
+        s = 1;
+    }
+    for (int r = 0; !tuneOnly && r < gReversals && n > 1; r++) {
+        size_t a = nextRand(s) % n;
+        size_t b = nextRand(s) % n;
+        if (a > b) {
+            std::swap(a, b);
+        }
+        std::reverse(order.begin() + a, order.begin() + b + 1);
+    }
+    if (tuneOnly) {
+        float fx = randScale(s);
+        float fy = randScale(s);
+        tu.maxVelX     *= fx;
+        tu.accelX      *= fx;
+        tu.shortAccelX *= fx;
+        tu.maxVelY     *= fy;
+        tu.accelY      *= fy;
+        tu.shortAccelY *= fy;
+    }
+}
+
+// ---------------- Single-machine path ----------------
+
+/*
+  simulateOne():
+  Reference: one variant, one move at a time, through simMoveTime().
+*/
+static float simulateOne(const std::vector<uint32_t>& order, const Tuning& tu) {
+    float x = HOME_BACKOFF_X;
+    float y = HOME_BACKOFF_Y;
+    float t = 0;
+    for (size_t k = 0; k < order.size(); k++) {
+        float dx = gPx[order[k]] - x;
+        float dy = gPy[order[k]] - y;
+        float tx = 0;
+        float ty = 0;
+        if (dx != 0) {
+            tx = simMoveTime(gModel, 'X', dx, tu.maxVelX,
+                             profileSelectAccel(dx, SHORT_MOVE_STEPS, tu.shortAccelX, tu.accelX));
+        }
+        if (dy != 0) {
+            ty = simMoveTime(gModel, 'Y', dy, tu.maxVelY,
+                             profileSelectAccel(dy, SHORT_MOVE_STEPS, tu.shortAccelY, tu.accelY));
+        }
+        t += tx > ty ? tx : ty;
+        x = gPx[order[k]];
+        y = gPy[order[k]];
+    }
+    return t;
+}
+
+// ---------------- Batch path ----------------
+
+/*
+  Block: BLOCK machines, structure-of-arrays. The targets are laid out
+  move-major (tx[k * BLOCK + lane]) so pass k reads one contiguous row.
+  The step-rate ceilings are folded into the per-lane max speeds up front.
+*/
+struct Block {
+    uint32_t           first;   // variant of lane 0
+    uint32_t           lanes;   // used lanes (the rest repeat lane 0)
+    std::vector<float> tx, ty;
+    float x[BLOCK], y[BLOCK], t[BLOCK];
+    float vx[BLOCK], ax[BLOCK], sax[BLOCK];
+    float vy[BLOCK], ay[BLOCK], say[BLOCK];
+};
+
+static float capSpeed(float v, float cap) {
+    return (cap > 0 && cap < v) ? cap : v;
+}
+
+static void loadBlock(Block& b, uint32_t first, uint32_t lanes) {
+    size_t n = gPx.size();
+    b.first = first;
+    b.lanes = lanes;
+    b.tx.resize(n * BLOCK);
+    b.ty.resize(n * BLOCK);
+
+    std::vector<uint32_t> order;
+    Tuning                tu;
+    for (uint32_t l = 0; l < BLOCK; l++) {
+        makeVariant(first + (l < lanes ? l : 0), order, tu);
+        for (size_t k = 0; k < n; k++) {
+            b.tx[k * BLOCK + l] = gPx[order[k]];
+            b.ty[k * BLOCK + l] = gPy[order[k]];
+        }
+        b.x[l]   = HOME_BACKOFF_X;
+        b.y[l]   = HOME_BACKOFF_Y;
+        b.t[l]   = 0;
+        b.vx[l]  = capSpeed(tu.maxVelX, gModel.stepRateX);
+        b.ax[l]  = tu.accelX;
+        b.sax[l] = tu.shortAccelX;
+        b.vy[l]  = capSpeed(tu.maxVelY, gModel.stepRateY);
+        b.ay[l]  = tu.accelY;
+        b.say[l] = tu.shortAccelY;
+    }
+}
+
+/*
+  runBlock():
+  One kernel pass per move. The pass is branch-free per lane (profilePlan()
+  inlines to selects) so it vectorizes; an axis that does not move takes
+  no time and no overhead, as in simulateOne().
+*/
+static void runBlock(Block& b) {
+    const float ohX = gModel.overheadX;
+    const float ohY = gModel.overheadY;
+    size_t n = gPx.size();
+
+    for (size_t k = 0; k < n; k++) {
+        const float* __restrict__ tx = &b.tx[k * BLOCK];
+        const float* __restrict__ ty = &b.ty[k * BLOCK];
+        for (int l = 0; l < BLOCK; l++) {
+            float dx = tx[l] - b.x[l];
+            float dy = ty[l] - b.y[l];
+            float ax = profileSelectAccel(dx, SHORT_MOVE_STEPS, b.sax[l], b.ax[l]);
+            float ay = profileSelectAccel(dy, SHORT_MOVE_STEPS, b.say[l], b.ay[l]);
+            float tX = dx != 0 ? profilePlan(dx, b.vx[l], ax).totalTime + ohX : 0.0f;
+            float tY = dy != 0 ? profilePlan(dy, b.vy[l], ay).totalTime + ohY : 0.0f;
+            b.t[l] += tX > tY ? tX : tY;
+            b.x[l]  = tx[l];
+            b.y[l]  = ty[l];
+        }
+    }
+}
+
+// ---------------- Driver ----------------
+
+static bool loadPoints(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        float x, y;
+        if (line[0] != '#' && sscanf(line, "%f %f", &x, &y) == 2) {
+            gPx.push_back(x);
+            gPy.push_back(y);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+static void gridPoints() {
+    for (unsigned int i = 0; i < AUTO_NUM_X * AUTO_NUM_Y; i++) {
+        long x, y;
+        gridPoint(i, x, y);
+        gPx.push_back((float)x);
+        gPy.push_back((float)y);
+    }
+}
+
+static void usage() {
+    fprintf(stderr, "usage: batchSim [-n variants] [-t threads] [-m reversals] [--tune pct] [--seed s]\n"
+                    "                [-c simCal.txt] [-o best.txt] [--check] [points.txt]\n");
+}
+
+int main(int argc, char** argv) {
+    uint32_t    variants = 16384;
+    unsigned    threads  = std::thread::hardware_concurrency();
+    const char* calPath  = NULL;
+    const char* outPath  = NULL;
+    const char* ptsPath  = NULL;
+    bool        check    = false;
+
+    for (int i = 1; i < argc; i++) {
+        bool more = i + 1 < argc;
+        if      (!strcmp(argv[i], "-n") && more)     variants   = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-t") && more)     threads    = (unsigned)atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-m") && more)     gReversals = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--tune") && more) gTune      = (float)atof(argv[++i]) / 100.0f;
+        else if (!strcmp(argv[i], "--seed") && more) gSeed      = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "-c") && more)     calPath    = argv[++i];
+        else if (!strcmp(argv[i], "-o") && more)     outPath    = argv[++i];
+        else if (!strcmp(argv[i], "--check"))        check      = true;
+        else if (argv[i][0] != '-' && !ptsPath)      ptsPath    = argv[i];
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (variants == 0) {
+        variants = 1;
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    if (calPath && !simModelLoad(calPath, gModel)) {
+        perror(calPath);
+        return 1;
+    }
+    if (ptsPath) {
+        if (!loadPoints(ptsPath)) {
+            perror(ptsPath);
+            return 1;
+        }
+    } else {
+        gridPoints();
+    }
+    if (gPx.empty()) {
+        fprintf(stderr, "no points\n");
+        return 1;
+    }
+
+    uint32_t              blocks = (variants + BLOCK - 1) / BLOCK;
+    std::atomic<uint32_t> nextBlock(0);
+    std::atomic<uint32_t> mismatches(0);
+    std::mutex            lock;
+    Result                best[2]  = { { FLT_MAX, 0 }, { FLT_MAX, 0 } };   // order, tuning
+    float                 baseline = 0;
+    float                 worstErr = 0;
+
+    auto worker = [&]() {
+        Block  b;
+        Result mine[2] = { { FLT_MAX, 0 }, { FLT_MAX, 0 } };
+        float  err  = 0;
+        std::vector<uint32_t> order;
+        Tuning tu;
+
+        for (uint32_t bi; (bi = nextBlock++) < blocks; ) {
+            uint32_t first = bi * BLOCK;
+            uint32_t lanes = std::min<uint32_t>(BLOCK, variants - first);
+            loadBlock(b, first, lanes);
+            runBlock(b);
+            for (uint32_t l = 0; l < lanes; l++) {
+                Result& m = mine[variantTunes(first + l) ? 1 : 0];
+                if (b.t[l] < m.time) {
+                    m.time    = b.t[l];
+                    m.variant = first + l;
+                }
+                if (check) {
+                    makeVariant(first + l, order, tu);
+                    float d = fabsf(simulateOne(order, tu) - b.t[l]);
+                    if (d > 1e-4f * b.t[l]) {
+                        mismatches++;
+                    }
+                    err = std::max(err, d);
+                }
+            }
+            if (first == 0) {
+                std::lock_guard<std::mutex> g(lock);
+                baseline = b.t[0];
+            }
+        }
+
+        std::lock_guard<std::mutex> g(lock);
+        for (int k = 0; k < 2; k++) {
+            if (mine[k].time < best[k].time ||
+                (mine[k].time == best[k].time && mine[k].variant < best[k].variant)) {
+                best[k] = mine[k];
+            }
+        }
+        worstErr = std::max(worstErr, err);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; i++) {
+        pool.push_back(std::thread(worker));
+    }
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i].join();
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<uint32_t> order;
+    Tuning                tu;
+
+    printf("%zu points, %u variants, %u threads, block %d lanes\n", gPx.size(), variants, threads, BLOCK);
+    if (calPath) {
+        printf("Calibrated model %s: step rate X %g Y %g, overhead X %g s Y %g s\n",
+               calPath, gModel.stepRateX, gModel.stepRateY, gModel.overheadX, gModel.overheadY);
+    }
+    printf("%.3f s, %.0f variants/s%s\n\n", secs, variants / secs, check ? " (with --check)" : "");
+    printf("Job as given:  %10.3f s motion\n", baseline);
+    printf("Best order:    %10.3f s motion (#%u, %.1f%% faster)\n", best[0].time, best[0].variant,
+           baseline > 0 ? 100.0 * (baseline - best[0].time) / baseline : 0.0);
+    if (gTune > 0 && best[1].time < FLT_MAX) {
+        makeVariant(best[1].variant, order, tu);
+        printf("Best tuning:   %10.3f s motion (#%u, %+.1f%%)\n", best[1].time, best[1].variant,
+               baseline > 0 ? 100.0 * (best[1].time - baseline) / baseline : 0.0);
+        printf("  X max speed %.0f accel %.0f short %.0f\n", tu.maxVelX, tu.accelX, tu.shortAccelX);
+        printf("  Y max speed %.0f accel %.0f short %.0f\n", tu.maxVelY, tu.accelY, tu.shortAccelY);
+    }
+    makeVariant(best[0].variant, order, tu);
+
+    if (outPath) {
+        FILE* f = fopen(outPath, "w");
+        if (!f) {
+            perror(outPath);
+            return 1;
+        }
+        fprintf(f, "# batchSim variant %u, %.3f s\n", best[0].variant, best[0].time);
+        for (size_t k = 0; k < order.size(); k++) {
+            fprintf(f, "%.0f %.0f\n", gPx[order[k]], gPy[order[k]]);
+        }
+        fclose(f);
+    }
+
+    if (check) {
+        printf("\nCheck against single-machine path: max difference %g s, %u mismatches\n",
+               worstErr, (unsigned)mismatches);
+        return mismatches ? 1 : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+#!/bin/sh
+# goldenCheck: step-timing regression check of the firmware on the host.
+#
+# Builds tools/hostRun.cpp (the sketch against the host Arduino core in
+# tools/host/) and tools/stepTrace.cpp, runs every reference job and
+# compares its step timeline with tools/golden/<reference>.trc. Exit status 1
+# if any reference regresses or does not finish.
+#
+# After a deliberate timing change, rewrite the goldens with --update and
+# commit them together with the change.
+#
+# Run from anywhere:
+#     tools/goldenCheck.sh [--update]
+
+set -e
+cd "$(dirname "$0")/.."
+
+REFERENCES="grid stitch ring"
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+g++ -O2 -std=c++11 -Itools/host -o "$work/hostRun" tools/hostRun.cpp tools/host/[A-Z]*.cpp \
+    tools/host/host*.cpp goodEnough/[a-z]*.cpp -x c++ goodEnough/goodEnough.ino
+g++ -O2 -std=c++11 -o "$work/stepTrace" tools/stepTrace.cpp
+
+status=0
+for ref in $REFERENCES; do
+    if ! "$work/hostRun" "$ref" -o "$work/$ref.trc" 2>"$work/$ref.log"; then
+        cat "$work/$ref.log"
+        echo "$ref: DID NOT FINISH"
+        status=1
+        continue
+    fi
+    if [ "$1" = "--update" ]; then
+        cp "$work/$ref.trc" "tools/golden/$ref.trc"
+        echo "$ref: golden updated"
+    elif "$work/stepTrace" compare "tools/golden/$ref.trc" "$work/$ref.trc" >"$work/$ref.txt"; then
+        echo "$ref: MATCH"
+    else
+        cat "$work/$ref.txt"
+        echo "$ref: REGRESSION"
+        status=1
+    fi
+done
+exit $status
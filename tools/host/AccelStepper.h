@@ -0,0 +1,93 @@
+#pragma once
+
+// AccelStepper.h
+//
+// AccelStepper library for Arduino, version 1.64, by Mike McCauley.
+// This software is Copyright (C) 2010-2018 Mike McCauley. Use is subject to
+// license conditions; this copy is used under the GNU General Public License
+// version 3 (the library's open source licensing option), see COPYING in
+// this directory or https://www.gnu.org/licenses/gpl-3.0.html.
+//
+// Modified for the host build (tools/hostRun.cpp): the same speed algorithm,
+// member layout and pin sequence per step (dir, step high, minimum pulse
+// width, step low), so step timing on the simulated clock matches the
+// library on the Uno. Only the DRIVER and FUNCTION interfaces are kept, and
+// FUNCTION drives no callbacks.
+
+#include "Arduino.h"
+
+class AccelStepper {
+public:
+    typedef enum {
+        FUNCTION  = 0,
+        DRIVER    = 1,
+        FULL2WIRE = 2,
+        FULL3WIRE = 3,
+        FULL4WIRE = 4,
+        HALF3WIRE = 6,
+        HALF4WIRE = 8
+    } MotorInterfaceType;
+
+    AccelStepper(uint8_t interface = AccelStepper::FULL4WIRE, uint8_t pin1 = 2, uint8_t pin2 = 3,
+                 uint8_t pin3 = 4, uint8_t pin4 = 5, bool enable = true);
+    virtual ~AccelStepper() {}
+
+    void    moveTo(long absolute);
+    void    move(long relative);
+    boolean run();
+    boolean runSpeed();
+    void    setMaxSpeed(float speed);
+    float   maxSpeed();
+    void    setAcceleration(float acceleration);
+    float   acceleration();
+    void    setSpeed(float speed);
+    float   speed();
+    long    distanceToGo();
+    long    targetPosition();
+    long    currentPosition();
+    void    setCurrentPosition(long position);
+    void    runToPosition();
+    boolean runSpeedToPosition();
+    void    runToNewPosition(long position);
+    void    stop();
+    virtual void disableOutputs();
+    virtual void enableOutputs();
+    void    setMinPulseWidth(unsigned int minWidth);
+    void    setEnablePin(uint8_t enablePin = 0xff);
+    void    setPinsInverted(bool directionInvert = false, bool stepInvert = false,
+                            bool enableInvert = false);
+    bool    isRunning();
+
+protected:
+    typedef enum {
+        DIRECTION_CCW = 0,
+        DIRECTION_CW  = 1
+    } Direction;
+
+    void computeNewSpeed();
+    virtual void setOutputPins(uint8_t mask);
+    virtual void step(long step);
+    virtual void step0(long step);
+    virtual void step1(long step);
+
+    boolean _direction;
+
+private:
+    uint8_t       _interface;
+    uint8_t       _pin[4];
+    uint8_t       _pinInverted[4];
+    long          _currentPos;
+    long          _targetPos;
+    float         _speed;
+    float         _maxSpeed;
+    float         _acceleration;
+    unsigned long _stepInterval;
+    unsigned long _lastStepTime;
+    unsigned int  _minPulseWidth;
+    bool          _enableInverted;
+    uint8_t       _enablePin;
+    long          _n;
+    float         _c0;
+    float         _cn;
+    float         _cmin;
+};
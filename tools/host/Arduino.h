@@ -0,0 +1,170 @@
+#pragma once
+
+// Host stand-in for the Arduino core: just enough of the Uno API for the
+// sketch in goodEnough/ to build and run on a PC against a simulated clock
+// (see hostSim.h). Used by tools/hostRun.cpp.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW  0
+
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define PI      3.1415926535897932384626433832795
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI  6.283185307179586476925286766559
+
+#define DEC 10
+#define HEX 16
+
+#define F(s) (s)
+#define PROGMEM
+#define pgm_read_byte(p)  (*(const uint8_t*)(p))
+#define pgm_read_word(p)  (*(const uint16_t*)(p))
+#define pgm_read_dword(p) (*(const uint32_t*)(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#define noInterrupts()
+#define interrupts()
+
+#define bitRead(v, b)  (((v) >> (b)) & 1)
+#define bitSet(v, b)   ((v) |= (1UL << (b)))
+#define bitClear(v, b) ((v) &= ~(1UL << (b)))
+
+#define constrain(a, lo, hi) ((a) < (lo) ? (lo) : ((a) > (hi) ? (hi) : (a)))
+
+// The core's min/max/abs are macros; templates keep std headers usable
+template <class A, class B> inline A min(A a, B b) { return a < (A)b ? a : (A)b; }
+template <class A, class B> inline A max(A a, B b) { return a > (A)b ? a : (A)b; }
+template <class T> inline T abs(T a) { return a < 0 ? -a : a; }
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+long random(long hi);
+long random(long lo, long hi);
+void randomSeed(unsigned long seed);
+
+class String;
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t b) = 0;
+    virtual size_t write(const uint8_t* buf, size_t n);
+    size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+    size_t write(const char* s, size_t n) { return write((const uint8_t*)s, n); }
+
+    size_t print(const char* s);
+    size_t print(const String& s);
+    size_t print(char c);
+    size_t print(int v, int base = DEC);
+    size_t print(unsigned int v, int base = DEC);
+    size_t print(long v, int base = DEC);
+    size_t print(unsigned long v, int base = DEC);
+    size_t print(double v, int digits = 2);
+
+    size_t println();
+    size_t println(const char* s);
+    size_t println(const String& s);
+    size_t println(char c);
+    size_t println(int v, int base = DEC);
+    size_t println(unsigned int v, int base = DEC);
+    size_t println(long v, int base = DEC);
+    size_t println(unsigned long v, int base = DEC);
+    size_t println(double v, int digits = 2);
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+/**
+ * @brief Serial port with the Uno's 64-byte TX buffer drained at the baud
+ * rate in simulated time, so availableForWrite() and blocking writes
+ * behave like the real UART. Received bytes come from hostSerialInput().
+ */
+class HardwareSerial : public Stream {
+public:
+    void   begin(unsigned long baud);
+    void   end() {}
+    int    available();
+    int    read();
+    int    peek();
+    int    availableForWrite();
+    void   flush();
+    size_t write(uint8_t b);
+    using Print::write;
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @brief Arduino String on top of std::string (the subset the sketch uses).
+ */
+class String {
+public:
+    String(const char* s = "") : _s(s ? s : "") {}
+    String(const std::string& s) : _s(s) {}
+    explicit String(char c) : _s(1, c) {}
+    String(int v, unsigned char base = DEC);
+    String(unsigned int v, unsigned char base = DEC);
+    String(long v, unsigned char base = DEC);
+    String(unsigned long v, unsigned char base = DEC);
+    String(float v, unsigned char digits = 2);
+    String(double v, unsigned char digits = 2);
+
+    const char*  c_str() const { return _s.c_str(); }
+    unsigned int length() const { return (unsigned int)_s.size(); }
+    char         charAt(unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+    char         operator[](unsigned int i) const { return charAt(i); }
+    bool         concat(const String& s) { _s += s._s; return true; }
+    String&      operator+=(const String& s) { _s += s._s; return *this; }
+    String&      operator+=(const char* s) { _s += s; return *this; }
+    String&      operator+=(char c) { _s += c; return *this; }
+    bool         operator==(const String& s) const { return _s == s._s; }
+    bool         operator!=(const String& s) const { return _s != s._s; }
+    String       substring(unsigned int from) const { return String(_s.substr(from)); }
+    String       substring(unsigned int from, unsigned int to) const { return String(_s.substr(from, to - from)); }
+    int          indexOf(char c) const;
+    long         toInt() const { return atol(_s.c_str()); }
+
+    friend String operator+(const String& a, const String& b) { return String(a._s + b._s); }
+    friend String operator+(const String& a, const char* b) { return String(a._s + b); }
+    friend String operator+(const char* a, const String& b) { return String(a + b._s); }
+
+private:
+    std::string _s;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+// Host EEPROM: the Uno's 1 KB, erased (0xff) at start.
+
+#include "Arduino.h"
+
+class EEPROMClass {
+public:
+    EEPROMClass();
+
+    uint8_t  read(int addr) { return _data[addr]; }
+    void     write(int addr, uint8_t v) { _data[addr] = v; }
+    void     update(int addr, uint8_t v) { _data[addr] = v; }
+    uint16_t length() { return sizeof(_data); }
+
+    template <class T> T& get(int addr, T& t) {
+        memcpy(&t, &_data[addr], sizeof(T));
+        return t;
+    }
+    template <class T> const T& put(int addr, const T& t) {
+        memcpy(&_data[addr], &t, sizeof(T));
+        return t;
+    }
+
+private:
+    uint8_t _data[1024];
+};
+
+extern EEPROMClass EEPROM;
@@ -0,0 +1,16 @@
+#pragma once
+
+// Host Encoder: the knob never turns; the harness drives the menus through
+// the remote UI ('+' / '-' detents, see remoteUi.h).
+
+#include "Arduino.h"
+
+class Encoder {
+public:
+    Encoder(uint8_t pin1, uint8_t pin2) { (void)pin1; (void)pin2; }
+    int32_t read() { return _count; }
+    void    write(int32_t count) { _count = count; }
+
+private:
+    int32_t _count = 0;
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+// Host Servo: remembers the commanded pulse (544..2400 us, as the AVR library).
+
+#include "Arduino.h"
+
+class Servo {
+public:
+    uint8_t attach(int pin);
+    uint8_t attach(int pin, int min, int max);
+    void    detach() { _pin = -1; }
+    void    write(int angle);
+    void    writeMicroseconds(int us);
+    int     read();
+    int     readMicroseconds() { return _us; }
+    bool    attached() { return _pin >= 0; }
+
+private:
+    int _pin = -1;
+    int _us  = 1500;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+// Host Wire: writes cost their bus time on the simulated clock (hostSim.h).
+
+#include "Arduino.h"
+#include "hostSim.h"
+
+class TwoWire : public Stream {
+public:
+    void    begin();
+    void    setClock(uint32_t hz);
+    void    beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool stop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity);
+    size_t  write(uint8_t b);
+    size_t  write(const uint8_t* buf, size_t n);
+    int     available();
+    int     read();
+    int     peek();
+
+private:
+    uint32_t _hz    = HOST_I2C_HZ;
+    size_t   _bytes = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,14 @@
+#pragma once
+
+// Host stand-in for the AVR registers the sketch touches (warmStart.cpp).
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+#define PORF  0
+#define EXTRF 1
+#define BORF  2
+#define WDRF  3
+
+extern volatile uint8_t MCUSR;   // reset flags: 0 = warm reset
@@ -0,0 +1,16 @@
+#pragma once
+
+// Host watchdog: never fires.
+
+#define WDTO_15MS  0
+#define WDTO_30MS  1
+#define WDTO_60MS  2
+#define WDTO_120MS 3
+#define WDTO_250MS 4
+#define WDTO_500MS 5
+#define WDTO_1S    6
+#define WDTO_2S    7
+
+void wdt_enable(int timeout);
+void wdt_reset();
+void wdt_disable();
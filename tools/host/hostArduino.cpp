@@ -0,0 +1,398 @@
+/*
+  Host Arduino core: simulated clock, pins, UART, I2C, EEPROM, Servo and
+  Encoder for the sketch in goodEnough/ (interfaces in this directory,
+  simulation hooks in hostSim.h).
+*/
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "Encoder.h"
+#include "Servo.h"
+#include "Wire.h"
+#include "avr/io.h"
+#include "avr/wdt.h"
+#include "hostSim.h"
+
+#include <stdio.h>
+
+#include <deque>
+
+#define SERIAL_TX_BUFFER 64
+
+static uint64_t gNow = 0;
+
+struct WatchedAxis {
+    const char* name;
+    uint8_t     stepPin;
+    uint8_t     dirPin;
+    long        pos;
+};
+
+struct LimitSwitch {
+    int  axis;   // -1 = none
+    long trip;
+    int  sign;
+};
+
+static uint8_t     gPinLevel[HOST_PINS];
+static WatchedAxis gAxes[4];
+static int         gAxisCount = 0;
+static LimitSwitch gLimits[HOST_PINS];
+static bool        gLimitsInit = false;
+static FILE*       gTimeline = 0;
+
+// ---------------- Simulation hooks ----------------
+
+uint64_t hostNowUs() {
+    return gNow;
+}
+
+void hostAdvance(uint64_t us) {
+    gNow += us;
+}
+
+void hostWatchAxis(const char* name, uint8_t stepPin, uint8_t dirPin) {
+    WatchedAxis a = { name, stepPin, dirPin, 0 };
+    gAxes[gAxisCount++] = a;
+}
+
+static void initLimits() {
+    if (!gLimitsInit) {
+        for (int i = 0; i < HOST_PINS; i++) {
+            gLimits[i].axis = -1;
+        }
+        gLimitsInit = true;
+    }
+}
+
+void hostLimitSwitch(uint8_t pin, int axis, long trip, int sign) {
+    initLimits();
+    gLimits[pin].axis = axis;
+    gLimits[pin].trip = trip;
+    gLimits[pin].sign = sign;
+}
+
+long hostAxisPosition(int axis) {
+    return gAxes[axis].pos;
+}
+
+void hostTimeline(FILE* f) {
+    gTimeline = f;
+    if (f) {
+        fprintf(f, "# stepTrace 1\n");
+    }
+}
+
+// ---------------- Pins and time ----------------
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < HOST_PINS && mode == INPUT_PULLUP) {
+        gPinLevel[pin] = HIGH;
+    }
+}
+
+// Steppers step on the rising edge of their step pin
+void digitalWrite(uint8_t pin, uint8_t value) {
+    gNow += HOST_CALL_US;
+    if (pin >= HOST_PINS) {
+        return;
+    }
+    bool rise = value && !gPinLevel[pin];
+    gPinLevel[pin] = value ? HIGH : LOW;
+    if (!rise) {
+        return;
+    }
+    for (int i = 0; i < gAxisCount; i++) {
+        WatchedAxis& a = gAxes[i];
+        if (a.stepPin == pin) {
+            int dir = gPinLevel[a.dirPin];
+            a.pos += dir ? 1 : -1;
+            if (gTimeline) {
+                fprintf(gTimeline, "%s %llu %d\n", a.name, (unsigned long long)gNow, dir);
+            }
+        }
+    }
+}
+
+// Inputs idle high (pull-ups, button released); limit switches close by position
+int digitalRead(uint8_t pin) {
+    gNow += HOST_CALL_US;
+    initLimits();
+    if (pin < HOST_PINS && gLimits[pin].axis >= 0) {
+        const LimitSwitch& l = gLimits[pin];
+        return gAxes[l.axis].pos * l.sign >= l.trip ? HIGH : LOW;
+    }
+    return HIGH;
+}
+
+void analogWrite(uint8_t, int) {
+    gNow += HOST_CALL_US;
+}
+
+unsigned long millis() {
+    gNow += HOST_CALL_US;
+    return (unsigned long)(uint32_t)(gNow / 1000);
+}
+
+unsigned long micros() {
+    gNow += HOST_CALL_US;
+    return (unsigned long)(uint32_t)gNow;
+}
+
+void delay(unsigned long ms) {
+    gNow += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+    gNow += us;
+}
+
+void yield() {}
+
+static unsigned long gRandom = 1;
+
+void randomSeed(unsigned long seed) {
+    gRandom = seed ? seed : 1;
+}
+
+long random(long hi) {
+    gRandom = gRandom * 1103515245UL + 12345UL;
+    return hi > 0 ? (long)((gRandom >> 8) % (unsigned long)hi) : 0;
+}
+
+long random(long lo, long hi) {
+    return lo + random(hi - lo);
+}
+
+// ---------------- Print / String ----------------
+
+size_t Print::write(const uint8_t* buf, size_t n) {
+    size_t done = 0;
+    while (n--) {
+        done += write(*buf++);
+    }
+    return done;
+}
+
+static size_t printNumber(Print& p, unsigned long v, int base, bool negative) {
+    char buf[24];
+    char* s = buf + sizeof(buf) - 1;
+    *s = '\0';
+    do {
+        int d = (int)(v % base);
+        *--s = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+        v /= base;
+    } while (v);
+    if (negative) {
+        *--s = '-';
+    }
+    return p.write(s);
+}
+
+size_t Print::print(const char* s)   { return write(s); }
+size_t Print::print(const String& s) { return write(s.c_str()); }
+size_t Print::print(char c)          { return write((uint8_t)c); }
+
+size_t Print::print(long v, int base) {
+    if (base == DEC && v < 0) {
+        return printNumber(*this, (unsigned long)-v, DEC, true);
+    }
+    return printNumber(*this, (unsigned long)v, base, false);
+}
+
+size_t Print::print(int v, int base)           { return print((long)v, base); }
+size_t Print::print(unsigned int v, int base)  { return printNumber(*this, v, base, false); }
+size_t Print::print(unsigned long v, int base) { return printNumber(*this, v, base, false); }
+
+size_t Print::print(double v, int digits) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    return write(buf);
+}
+
+size_t Print::println()                          { return write("\r\n"); }
+size_t Print::println(const char* s)             { return print(s) + println(); }
+size_t Print::println(const String& s)           { return print(s) + println(); }
+size_t Print::println(char c)                    { return print(c) + println(); }
+size_t Print::println(int v, int base)           { return print(v, base) + println(); }
+size_t Print::println(unsigned int v, int base)  { return print(v, base) + println(); }
+size_t Print::println(long v, int base)          { return print(v, base) + println(); }
+size_t Print::println(unsigned long v, int base) { return print(v, base) + println(); }
+size_t Print::println(double v, int digits)      { return print(v, digits) + println(); }
+
+static std::string formatNumber(unsigned long v, unsigned char base, bool negative) {
+    std::string s;
+    do {
+        int d = (int)(v % base);
+        s.insert(s.begin(), (char)(d < 10 ? '0' + d : 'a' + d - 10));
+        v /= base;
+    } while (v);
+    if (negative) {
+        s.insert(s.begin(), '-');
+    }
+    return s;
+}
+
+String::String(long v, unsigned char base)
+    : _s(base == DEC && v < 0 ? formatNumber((unsigned long)-v, DEC, true)
+                              : formatNumber((unsigned long)v, base, false)) {}
+String::String(int v, unsigned char base) : String((long)v, base) {}
+String::String(unsigned int v, unsigned char base) : _s(formatNumber(v, base, false)) {}
+String::String(unsigned long v, unsigned char base) : _s(formatNumber(v, base, false)) {}
+String::String(float v, unsigned char digits) : String((double)v, digits) {}
+
+String::String(double v, unsigned char digits) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    _s = buf;
+}
+
+int String::indexOf(char c) const {
+    size_t i = _s.find(c);
+    return i == std::string::npos ? -1 : (int)i;
+}
+
+// ---------------- Serial ----------------
+
+HardwareSerial Serial;
+
+static std::deque<uint8_t> gRx;
+static unsigned long       gBaud     = 115200;
+static uint64_t            gTxFreeAt = 0;   // when the last queued byte has left
+
+// Bytes still in the TX buffer now (10 bits each on the wire)
+static int txQueued() {
+    if (gTxFreeAt <= gNow) {
+        return 0;
+    }
+    uint64_t byteUs = 10000000ULL / gBaud;
+    return (int)((gTxFreeAt - gNow + byteUs - 1) / byteUs);
+}
+
+void hostSerialInput(const char* bytes) {
+    while (*bytes) {
+        gRx.push_back((uint8_t)*bytes++);
+    }
+}
+
+void HardwareSerial::begin(unsigned long baud) {
+    gBaud = baud;
+}
+
+int HardwareSerial::available() {
+    gNow += HOST_CALL_US;
+    return (int)gRx.size();
+}
+
+int HardwareSerial::read() {
+    if (gRx.empty()) {
+        return -1;
+    }
+    int b = gRx.front();
+    gRx.pop_front();
+    return b;
+}
+
+int HardwareSerial::peek() {
+    return gRx.empty() ? -1 : gRx.front();
+}
+
+int HardwareSerial::availableForWrite() {
+    return SERIAL_TX_BUFFER - 1 - txQueued();
+}
+
+void HardwareSerial::flush() {
+    if (gTxFreeAt > gNow) {
+        gNow = gTxFreeAt;
+    }
+}
+
+// Blocks while the buffer is full, like the AVR core
+size_t HardwareSerial::write(uint8_t) {
+    uint64_t byteUs = 10000000ULL / gBaud;
+    while (availableForWrite() <= 0) {
+        gNow += byteUs;
+    }
+    gTxFreeAt = (gTxFreeAt > gNow ? gTxFreeAt : gNow) + byteUs;
+    gNow += HOST_CALL_US;
+    return 1;
+}
+
+// ---------------- Wire (I2C master, writes only) ----------------
+
+TwoWire Wire;
+
+void TwoWire::begin() {}
+
+void TwoWire::setClock(uint32_t hz) {
+    _hz = hz;
+}
+
+void TwoWire::beginTransmission(uint8_t) {
+    _bytes = 1;   // address byte
+}
+
+size_t TwoWire::write(uint8_t) {
+    _bytes++;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* buf, size_t n) {
+    (void)buf;
+    _bytes += n;
+    return n;
+}
+
+// The transfer blocks for its bus time: 9 clocks per byte plus start/stop
+uint8_t TwoWire::endTransmission(bool) {
+    gNow += (uint64_t)(_bytes * 9 + 2) * 1000000ULL / _hz;
+    _bytes = 0;
+    return 0;
+}
+
+int TwoWire::available() { return 0; }
+int TwoWire::read()      { return -1; }
+int TwoWire::peek()      { return -1; }
+
+uint8_t TwoWire::requestFrom(uint8_t, uint8_t) {
+    return 0;
+}
+
+// ---------------- EEPROM ----------------
+
+EEPROMClass EEPROM;
+
+EEPROMClass::EEPROMClass() {
+    memset(_data, 0xff, sizeof(_data));   // erased
+}
+
+// ---------------- Servo / Encoder ----------------
+
+uint8_t Servo::attach(int pin) {
+    _pin = pin;
+    return 1;
+}
+
+uint8_t Servo::attach(int pin, int, int) {
+    return attach(pin);
+}
+
+void Servo::write(int angle) {
+    writeMicroseconds(544 + (long)constrain(angle, 0, 180) * (2400 - 544) / 180);
+}
+
+void Servo::writeMicroseconds(int us) {
+    _us = us;
+}
+
+int Servo::read() {
+    return (int)((long)(_us - 544) * 180 / (2400 - 544));
+}
+
+// ---------------- AVR registers ----------------
+
+volatile uint8_t MCUSR = 0;
+
+void wdt_enable(int) {}
+void wdt_reset() {}
+void wdt_disable() {}
@@ -0,0 +1,55 @@
+#pragma once
+
+// Simulated machine behind the host Arduino core (hostArduino.cpp).
+//
+// Time only moves when the sketch touches the hardware: every micros(),
+// millis() and digital I/O call costs HOST_CALL_US, delay() and
+// delayMicroseconds() advance by their argument, I2C bytes by their bus
+// time and Serial writes block while the TX buffer is full. The same build
+// and input therefore always give the same step timeline.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define HOST_CALL_US   4       // AVR cost of micros() / digitalWrite() and the code around it
+#define HOST_I2C_HZ    100000  // Wire clock (the sketch keeps the default)
+#define HOST_PINS      20
+
+/**
+ * @brief Simulated time since reset (us).
+ */
+uint64_t hostNowUs();
+
+/**
+ * @brief Advances the simulated clock.
+ */
+void hostAdvance(uint64_t us);
+
+/**
+ * @brief Queues bytes for Serial.read() (remote UI keys).
+ */
+void hostSerialInput(const char* bytes);
+
+/**
+ * @brief Axis whose step/dir pins are watched: steps are written to the
+ * timeline as "<name> <us> <dir>" (tools/stepTrace.cpp format) and tracked
+ * as a physical position for the limit switches.
+ */
+void hostWatchAxis(const char* name, uint8_t stepPin, uint8_t dirPin);
+
+/**
+ * @brief Limit switch on pin: reads HIGH while the watched axis (index in
+ * hostWatchAxis() order) is at or beyond trip steps from where it started,
+ * in the direction of sign (+1 / -1).
+ */
+void hostLimitSwitch(uint8_t pin, int axis, long trip, int sign);
+
+/**
+ * @brief Physical step count of a watched axis since reset.
+ */
+long hostAxisPosition(int axis);
+
+/**
+ * @brief Starts writing the step timeline to f (NULL = stop).
+ */
+void hostTimeline(FILE* f);
@@ -0,0 +1,243 @@
+/*
+  hostRun: runs the firmware on the PC and records its step timeline.
+
+  The whole sketch (every source in goodEnough/) is built against
+  the host Arduino core in tools/host/: AccelStepper is the library's own
+  algorithm, and time is a simulated clock that every hardware access
+  advances (hostSim.h). The machine is two limit switches a few hundred
+  steps from power-on position, an erased EEPROM and the Serial remote UI as
+  the only operator. A reference drives the menus the way an operator would,
+  by waiting for text on the LCD shadow and sending remote UI keys, and every
+  step pulse of X1, X2 and Y from power-on to "Auto Complete" is written to
+  the timeline in the stepTrace format. Same build, same timeline: compare it
+  with tools/stepTrace.cpp against the golden file in tools/golden/ to see
+  whether a change moved any step (tools/goldenCheck.sh does both).
+  tools/host/AccelStepper.* is a modified copy of the GPL v3 AccelStepper
+  library and keeps its license (tools/host/COPYING).
+
+  References:
+      grid     1. Start: the standard grid, one click per point
+      stitch   2. Stitch Start: the grid welded column by column on the fly
+      ring     3. Run Job: job "RING" (a point, then two half circles through
+               the path planner) with a dwell recipe, no clicks
+
+  Build and run from the repo root:
+      g++ -O2 -std=c++11 -Itools/host -o hostRun tools/hostRun.cpp tools/host/[A-Z]*.cpp \
+          tools/host/host*.cpp goodEnough/[a-z]*.cpp -x c++ goodEnough/goodEnough.ino
+      ./hostRun grid -o grid.trc [-v]
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../goodEnough/functions.h"
+#include "host/hostSim.h"
+
+void setup();
+void loop();
+
+#define LIMIT_X_TRIP   400       // steps from power-on until X1 reaches its switch
+#define LIMIT_Y_TRIP   300       // same for Y (the switch is on the - side)
+#define KEY_SPACING_MS 150       // between remote keys, so each is its own gesture
+#define RUN_LIMIT_S    900       // simulated time before a reference is abandoned
+
+#define RING_RECIPE   1
+#define RING_CENTER_X -2400
+#define RING_CENTER_Y 700
+#define RING_RADIUS   400
+
+/**
+ * @brief One step of a reference: once any LCD row shows `wait`, send
+ * `keys`. A repeating step reacts to every new screen that shows its text
+ * until the next step's text appears. The last step ends the run.
+ */
+struct ScriptStep {
+    const char* wait;
+    const char* keys;
+    bool        repeat;
+};
+
+struct Reference {
+    const char*       name;
+    const ScriptStep* steps;
+};
+
+static const ScriptStep kGrid[] = {
+    { "1. Automatic Mode", "c", false },
+    { "1. Start",          "c", false },
+    { " ready",            "c", true },
+    { "Auto Complete",     0,   false },
+};
+
+static const ScriptStep kStitch[] = {
+    { "1. Automatic Mode", "c",  false },
+    { "2. Stitch Start",   "+c", false },
+    { "Auto Complete",     0,    false },
+};
+
+static const ScriptStep kRing[] = {
+    { "1. Automatic Mode", "c",  false },
+    { "3. Run Job",        "++c", false },
+    { "1/2 GRID",          "+",  false },
+    { "2/2 RING",          "c",  false },
+    { "Auto Complete",     0,    false },
+};
+
+static const Reference kReferences[] = {
+    { "grid",   kGrid },
+    { "stitch", kStitch },
+    { "ring",   kRing },
+};
+
+// Remote keys not yet sent, one per KEY_SPACING_MS (across steps too: a
+// click must be released before the next screen's key)
+static const char* gKeys   = "";
+static uint64_t    gNextKey = 0;
+
+static bool gVerbose = false;   // -v: log the keys sent per step
+
+static void serviceKeys() {
+    if (*gKeys && hostNowUs() >= gNextKey) {
+        char k[2] = { *gKeys++, '\0' };
+        hostSerialInput(k);
+        gNextKey = hostNowUs() + KEY_SPACING_MS * 1000ULL;
+    }
+}
+
+// LCD shadow rows are fixed-width, not NUL-terminated
+static void rowText(uint8_t row, char* out) {
+    memcpy(out, lcd.shadowRow(row), LCD_COLUMNS);
+    out[LCD_COLUMNS] = '\0';
+}
+
+static bool screenShows(const char* text) {
+    char row[LCD_COLUMNS + 1];
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        rowText(r, row);
+        if (strstr(row, text)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Screen identity, so a repeating step reacts once per screen
+static void screenText(char* out) {
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        rowText(r, out + r * LCD_COLUMNS);
+    }
+}
+
+static void printScreen() {
+    char row[LCD_COLUMNS + 1];
+    for (uint8_t r = 0; r < LCD_ROWS; r++) {
+        rowText(r, row);
+        fprintf(stderr, "  |%s|\n", row);
+    }
+}
+
+// Job "RING": a point on the circle, then two half circles back to it
+static void storeRing() {
+    JobRecipe r;
+    r.probeDown = PROBE_DOWN_ANGLE;
+    r.settleMs  = PROBE_SETTLE_MS;
+    r.dwellMs   = 200;
+    jobSetRecipe(RING_RECIPE, r);
+
+    long sx = RING_CENTER_X + RING_RADIUS;
+    jobBegin("RING", RING_RECIPE);
+    jobAddPoint(sx, RING_CENTER_Y);
+    jobAddArc(RING_CENTER_X - RING_RADIUS, RING_CENTER_Y, RING_CENTER_X, RING_CENTER_Y, true);
+    jobAddArc(sx, RING_CENTER_Y, RING_CENTER_X, RING_CENTER_Y, true);
+    jobEnd();
+}
+
+static int runReference(const Reference& ref, FILE* out) {
+    hostWatchAxis("X1", MOTOR_X1_STEP_PIN, MOTOR_X1_DIR_PIN);
+    hostWatchAxis("X2", MOTOR_X2_STEP_PIN, MOTOR_X2_DIR_PIN);
+    hostWatchAxis("Y", MOTOR_Y_STEP_PIN, MOTOR_Y_DIR_PIN);
+    hostLimitSwitch(LIMIT_X, 0, LIMIT_X_TRIP, 1);
+    hostLimitSwitch(LIMIT_Y, 2, LIMIT_Y_TRIP, -1);
+    hostTimeline(out);
+
+    hostSerialInput("c");   // "Push Button To Begin"
+    setup();
+    storeRing();            // next to the GRID job fsmInit() seeded
+
+    const ScriptStep* step = ref.steps;
+    char lastScreen[LCD_ROWS * LCD_COLUMNS + 1] = "";
+    char screen[sizeof(lastScreen)];
+
+    while (hostNowUs() < RUN_LIMIT_S * 1000000ULL) {
+        loop();
+        serviceKeys();
+
+        if (step->repeat && screenShows(step[1].wait)) {
+            step++;
+        }
+        if (!screenShows(step->wait)) {
+            continue;
+        }
+        if (!step->keys) {
+            return 0;   // last step reached
+        }
+        screenText(screen);
+        if (*gKeys || strcmp(screen, lastScreen) == 0) {
+            continue;   // previous keys still going out, or same screen
+        }
+        strcpy(lastScreen, screen);
+        if (gVerbose) {
+            fprintf(stderr, "%8.3f s  \"%s\" -> %s\n", hostNowUs() / 1e6, step->wait, step->keys);
+        }
+        gKeys = step->keys;   // still KEY_SPACING_MS after the previous key
+        if (!step->repeat) {
+            step++;
+        }
+    }
+
+    fprintf(stderr, "%s: no \"%s\" after %d s; screen:\n", ref.name, step->wait, RUN_LIMIT_S);
+    printScreen();
+    return 1;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: hostRun grid|stitch|ring [-o run.trc] [-v]\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    const Reference* ref = 0;
+    for (size_t i = 0; i < sizeof(kReferences) / sizeof(kReferences[0]); i++) {
+        if (strcmp(argv[1], kReferences[i].name) == 0) {
+            ref = &kReferences[i];
+        }
+    }
+    const char* outPath = 0;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (strcmp(argv[i], "-v") == 0) {
+            gVerbose = true;
+        }
+    }
+    if (!ref) {
+        usage();
+        return 2;
+    }
+
+    FILE* out = outPath ? fopen(outPath, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "cannot write %s\n", outPath);
+        return 2;
+    }
+    int rc = runReference(*ref, out);
+    fprintf(stderr, "%s: %.3f s simulated, X1 at %ld, Y at %ld\n", ref->name, hostNowUs() / 1e6,
+            hostAxisPosition(0), hostAxisPosition(2));
+    if (outPath) {
+        fclose(out);
+    }
+    return rc;
+}
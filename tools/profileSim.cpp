@@ -0,0 +1,108 @@
+/*
+  profileSim: host-side cycle-time estimate for the standard auto grid.
+
+  Replays the move sequence of handleAutoRun() (column X moves of AUTO_X_STEP,
+  Y hops to (row + 1) * Y_MOVE, Y return at the start of every column) through
+  the same trapezoid math the firmware uses (goodEnough/profile.h), once with
+  the long-move accelerations only and once with distance-aware selection
+  (profileSelectAccel), and reports the motion time saved.
+
+  The probe down / up profiles (plus the calibrated servo offset) and the
+  one LCD line written per point (at the calibrated cost per byte) are the
+  same in both runs; they are added as a per-point time to give the cycle
+  time. Early descent overlap, dwell and operator time are not modelled.
+  AccelStepper's stepped ramp is close to, not exactly, the ideal trapezoid;
+  pass a calibration from traceFit (simModel.h) to add the measured step-rate
+  ceilings, per-move overheads, servo offset and LCD cost.
+
+  Build and run from the repo root:
+      g++ -O2 -std=c++11 -o profileSim tools/profileSim.cpp && ./profileSim [simCal.txt]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../goodEnough/motionConfig.h"
+#include "../goodEnough/profile.h"
+#include "simModel.h"
+
+// Bytes one lcdPrintLine() sends to the I2C expander (as traced):
+// cursor command + full 20-column row, 4 bytes per character
+#define LCD_LINE_BYTES (4 * (20 + 1))
+
+struct MoveStats {
+    int    count;
+    double baseline; // seconds with X_ACCEL / Y_ACCEL only
+    double selected; // seconds with profileSelectAccel()
+};
+
+static SimModel gModel = simModelNominal();
+
+static void addMove(MoveStats& st, char axis, long distance, float maxVel, float longAccel, float shortAccel) {
+    if (distance == 0) {
+        return;
+    }
+    float a = profileSelectAccel((float)distance, SHORT_MOVE_STEPS, shortAccel, longAccel);
+    st.count++;
+    st.baseline += simMoveTime(gModel, axis, (float)distance, maxVel, longAccel);
+    st.selected += simMoveTime(gModel, axis, (float)distance, maxVel, a);
+}
+
+static void printRow(const char* name, const MoveStats& st) {
+    printf("%-10s %6d %12.3f %12.3f %12.3f\n",
+           name, st.count, st.baseline, st.selected, st.baseline - st.selected);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && !simModelLoad(argv[1], gModel)) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    MoveStats xMoves = { 0, 0, 0 };
+    MoveStats yHops  = { 0, 0, 0 };
+    MoveStats yBack  = { 0, 0, 0 };
+
+    long x = HOME_BACKOFF_X;
+    long y = HOME_BACKOFF_Y;
+
+    for (int col = 0; col < AUTO_NUM_X; col++) {
+        addMove(xMoves, 'X', AUTO_X_STEP, X_MAX_SPEED, X_ACCEL, X_SHORT_ACCEL);
+        x += AUTO_X_STEP;
+
+        for (int row = 0; row < AUTO_NUM_Y; row++) {
+            long target = (long)((row + 1) * Y_MOVE);
+            addMove(row == 0 ? yBack : yHops, 'Y', target - y, Y_MAX_SPEED, Y_ACCEL, Y_SHORT_ACCEL);
+            y = target;
+        }
+    }
+
+    MoveStats total = { xMoves.count + yHops.count + yBack.count,
+                        xMoves.baseline + yHops.baseline + yBack.baseline,
+                        xMoves.selected + yHops.selected + yBack.selected };
+
+    // Per point: probe down and back up, one status line
+    float probeS = 2 * (profilePlan(PROBE_DOWN_ANGLE - PROBE_UP_ANGLE, SERVO_MAX_VEL, SERVO_ACCEL).totalTime +
+                        gModel.servoOffset);
+    float lcdS   = LCD_LINE_BYTES * gModel.lcdUsPerByte * 1e-6f;
+    int   points = AUTO_NUM_X * AUTO_NUM_Y;
+    double perPoint = points * (double)(probeS + lcdS);
+
+    printf("Grid %d x %d, short moves <= %d steps (X accel %d -> %d, Y accel %d -> %d)\n\n",
+           AUTO_NUM_X, AUTO_NUM_Y, SHORT_MOVE_STEPS, X_ACCEL, X_SHORT_ACCEL, Y_ACCEL, Y_SHORT_ACCEL);
+    if (argc > 1) {
+        printf("Calibrated model %s: step rate X %g Y %g, overhead X %g s Y %g s\n\n",
+               argv[1], gModel.stepRateX, gModel.stepRateY, gModel.overheadX, gModel.overheadY);
+    }
+    printf("%-10s %6s %12s %12s %12s\n", "move", "count", "baseline s", "selected s", "saved s");
+    printRow("X column", xMoves);
+    printRow("Y hop", yHops);
+    printRow("Y return", yBack);
+    printRow("total", total);
+    printf("\nMotion time saved: %.1f%%\n",
+           total.baseline > 0 ? 100.0 * (total.baseline - total.selected) / total.baseline : 0.0);
+    printf("\nPer point: probe %.3f s, LCD %.4f s (%d points, %.3f s)\n", probeS, lcdS, points, perPoint);
+    printf("Cycle time: baseline %.3f s, selected %.3f s\n",
+           total.baseline + perPoint, total.selected + perPoint);
+    return 0;
+}
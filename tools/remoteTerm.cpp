@@ -0,0 +1,203 @@
+/*
+  remoteTerm: PC-side client for the firmware's Serial remote UI (remoteUi.h).
+
+  Renders the mirrored 20x4 LCD in the terminal and turns keys into virtual
+  encoder/button input. Any Serial line that is not part of the mirror
+  protocol (benchmarks, debug prints) is shown in a log line under the screen.
+  Run one instance per machine/port.
+
+  Keys:
+      Left / Right, - / +   encoder one detent
+      Enter / Space         click
+      l                     long press
+      s                     resync the whole screen
+      q                     quit
+
+  Build and run (Linux / macOS):
+      g++ -O2 -std=c++11 -o remoteTerm tools/remoteTerm.cpp
+      ./remoteTerm /dev/ttyUSB0
+*/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/select.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define COLS 20
+#define ROWS 4
+
+static char gScreen[ROWS][COLS];
+static int  gCurCol = 0;
+static int  gCurRow = 0;
+static bool gBlink  = false;
+static char gLog[128] = "";
+
+static struct termios gStdinSaved;
+
+static int openPort(const char* path) {
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct termios tio;
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tcsetattr(fd, TCSANOW, &tio);
+    return fd;
+}
+
+static void stdinRaw() {
+    struct termios tio;
+    tcgetattr(STDIN_FILENO, &gStdinSaved);
+    tio = gStdinSaved;
+    tio.c_lflag &= ~(ICANON | ECHO);
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &tio);
+}
+
+static void stdinRestore() {
+    tcsetattr(STDIN_FILENO, TCSANOW, &gStdinSaved);
+}
+
+static void render() {
+    printf("\x1b[H\x1b[2J");
+    printf("+--------------------+\r\n");
+    for (int r = 0; r < ROWS; r++) {
+        printf("|");
+        for (int c = 0; c < COLS; c++) {
+            bool cur = gBlink && r == gCurRow && c == gCurCol;
+            if (cur) printf("\x1b[7m");
+            putchar(gScreen[r][c]);
+            if (cur) printf("\x1b[0m");
+        }
+        printf("|\r\n");
+    }
+    printf("+--------------------+\r\n");
+    printf("<-/-> turn  Enter click  l hold  s resync  q quit\r\n");
+    printf("%s\r\n", gLog);
+    fflush(stdout);
+}
+
+// Applies one protocol line; returns false for lines that are not protocol.
+static bool applyLine(const char* line) {
+    int row, col, blink;
+
+    if (strcmp(line, "Z") == 0) {
+        memset(gScreen, ' ', sizeof(gScreen));
+        return true;
+    }
+    if (line[0] == 'D' && sscanf(line + 1, "%d,%d,", &row, &col) == 2 &&
+        row >= 0 && row < ROWS && col >= 0 && col < COLS) {
+        const char* text = strchr(strchr(line, ',') + 1, ',') + 1;
+        for (int i = 0; text[i] != '\0' && col + i < COLS; i++) {
+            gScreen[row][col + i] = text[i];
+        }
+        return true;
+    }
+    if (line[0] == 'K' && sscanf(line + 1, "%d,%d,%d", &col, &row, &blink) == 3) {
+        gCurCol = col;
+        gCurRow = row;
+        gBlink  = blink != 0;
+        return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <serial port>\n", argv[0]);
+        return 1;
+    }
+    int port = openPort(argv[1]);
+    if (port < 0) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    memset(gScreen, ' ', sizeof(gScreen));
+    stdinRaw();
+    write(port, "s", 1);   // ask for the full screen
+    render();
+
+    char line[64];
+    int  lineLen = 0;
+    int  escape  = 0;      // arrow-key escape sequence progress
+
+    for (;;) {
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(STDIN_FILENO, &fds);
+        FD_SET(port, &fds);
+        if (select(port + 1, &fds, 0, 0, 0) < 0) {
+            break;
+        }
+
+        if (FD_ISSET(port, &fds)) {
+            char buf[256];
+            int n = read(port, buf, sizeof(buf));
+            if (n <= 0) {
+                break;
+            }
+            bool dirty = false;
+            for (int i = 0; i < n; i++) {
+                if (buf[i] == '\r') {
+                    continue;
+                }
+                if (buf[i] != '\n') {
+                    if (lineLen < (int)sizeof(line) - 1) line[lineLen++] = buf[i];
+                    continue;
+                }
+                line[lineLen] = '\0';
+                lineLen = 0;
+                if (!applyLine(line)) {
+                    snprintf(gLog, sizeof(gLog), "log: %s", line);
+                }
+                dirty = true;
+            }
+            if (dirty) {
+                render();
+            }
+        }
+
+        if (FD_ISSET(STDIN_FILENO, &fds)) {
+            char k;
+            if (read(STDIN_FILENO, &k, 1) != 1) {
+                break;
+            }
+            const char* out = 0;
+            if (escape == 0 && k == 0x1b)      { escape = 1; continue; }
+            if (escape == 1 && k == '[')       { escape = 2; continue; }
+            if (escape == 2) {
+                escape = 0;
+                if (k == 'C') out = "+";
+                if (k == 'D') out = "-";
+            } else {
+                escape = 0;
+                switch (k) {
+                case '+': case '=':  out = "+"; break;
+                case '-':            out = "-"; break;
+                case '\n': case ' ': out = "c"; break;
+                case 'l':            out = "L"; break;
+                case 's':            out = "s"; break;
+                case 'q':
+                    stdinRestore();
+                    close(port);
+                    return 0;
+                }
+            }
+            if (out) {
+                write(port, out, 1);
+            }
+        }
+    }
+
+    stdinRestore();
+    close(port);
+    return 0;
+}
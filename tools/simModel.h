@@ -0,0 +1,74 @@
+#pragma once
+
+// Calibrated timing model shared by the host tools. traceFit fits it to
+// device traces (goodEnough/timingTrace.h) and saves it; profileSim loads it.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../goodEnough/profile.h"
+
+/**
+ * @brief Corrections on top of the ideal trapezoid / profile times.
+ */
+struct SimModel {
+    float stepRateX;    ///< effective step-rate ceiling of the X gantry (steps/s), 0 = none
+    float stepRateY;    ///< same for Y
+    float overheadX;    ///< fixed time per X move, command to detected arrival (s)
+    float overheadY;    ///< same for Y
+    float lcdUsPerByte; ///< LCD cost per I2C expander byte (us)
+    float servoOffset;  ///< probe move time beyond its profile (s)
+};
+
+/**
+ * @brief Uncalibrated model: ideal trapezoids, 100 kHz I2C at 9 bits per byte.
+ */
+inline SimModel simModelNominal() {
+    SimModel m = { 0, 0, 0, 0, 90.0f, 0 };
+    return m;
+}
+
+/**
+ * @brief Predicted time (s) of a plain point-to-point move on axis 'X' or 'Y'.
+ */
+inline float simMoveTime(const SimModel& m, char axis, float steps, float maxVel, float accel) {
+    float cap = (axis == 'X') ? m.stepRateX : m.stepRateY;
+    float v   = (cap > 0 && cap < maxVel) ? cap : maxVel;
+    return profilePlan(steps, v, accel).totalTime + ((axis == 'X') ? m.overheadX : m.overheadY);
+}
+
+/**
+ * @brief Saves the model as "key value" lines.
+ */
+inline bool simModelSave(const char* path, const SimModel& m) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "stepRateX %g\nstepRateY %g\noverheadX %g\noverheadY %g\nlcdUsPerByte %g\nservoOffset %g\n",
+            m.stepRateX, m.stepRateY, m.overheadX, m.overheadY, m.lcdUsPerByte, m.servoOffset);
+    fclose(f);
+    return true;
+}
+
+/**
+ * @brief Loads a model saved by simModelSave(); missing keys keep their value.
+ */
+inline bool simModelLoad(const char* path, SimModel& m) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char  key[32];
+    float v;
+    while (fscanf(f, "%31s %f", key, &v) == 2) {
+        if      (strcmp(key, "stepRateX") == 0)    m.stepRateX    = v;
+        else if (strcmp(key, "stepRateY") == 0)    m.stepRateY    = v;
+        else if (strcmp(key, "overheadX") == 0)    m.overheadX    = v;
+        else if (strcmp(key, "overheadY") == 0)    m.overheadY    = v;
+        else if (strcmp(key, "lcdUsPerByte") == 0) m.lcdUsPerByte = v;
+        else if (strcmp(key, "servoOffset") == 0)  m.servoOffset  = v;
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,319 @@
+/*
+  stepTrace: golden step-timeline recorder and comparator.
+
+  Catches refactors of the motion code that silently change step timing.
+  The step/direction pins are captured with a logic analyzer while the
+  machine runs a reference job; this tool turns the capture into a step
+  timeline and compares a new build's timeline against a stored golden one.
+
+  record: converts a logic-analyzer CSV export (e.g. sigrok-cli -O csv) into
+  a timeline file. The first non-comment line must name the columns; the
+  first column is the time in seconds, the others 0/1 pin levels. Rows may
+  be periodic samples or only the changes.
+      ./stepTrace record capture.csv -o run.trc [-x1 D2,D5] [-x2 D4,D7] [-y D3,D6]
+  (step,dir column names; defaults are the Arduino pin numbers, X2 optional)
+
+  compare: splits both timelines into moves (a pause longer than the gap or
+  a direction change ends a move), pairs the moves per axis in order and
+  reports, per move, the start offset, duration change and worst per-step
+  timing deviation, plus the overall cycle-time change. Exit status 1 on a regression:
+  different move/step counts or directions, a step deviation over the
+  tolerance, or a cycle time change over the tolerance.
+      ./stepTrace compare golden.trc run.trc [--tol-us 500] [--tol-pct 1] [--gap-ms 20]
+
+  Timeline file: "# stepTrace 1" then one "<axis> <us> <dir>" line per step.
+  tools/hostRun.cpp writes the same format from the firmware running on the
+  host; tools/goldenCheck.sh compares those against tools/golden/.
+
+  Build from the repo root:
+      g++ -O2 -std=c++11 -o stepTrace tools/stepTrace.cpp
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#define AXES 3
+
+static const char* kAxisName[AXES] = { "X1", "X2", "Y" };
+
+struct Step {
+    double us;
+    int    dir;
+};
+
+struct Timeline {
+    std::vector<Step> axis[AXES];
+};
+
+struct Move {
+    size_t first;   // index of the first step
+    size_t count;
+    double start;   // us
+    double end;
+    long   net;     // signed steps (dir 1 = +)
+};
+
+// ---------------- Capture -> timeline ----------------
+
+static int findColumn(const std::vector<std::string>& cols, const std::string& name) {
+    for (size_t i = 0; i < cols.size(); i++) {
+        if (cols[i] == name) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static std::vector<std::string> splitCsv(const char* line) {
+    std::vector<std::string> out;
+    std::string cur;
+    for (const char* p = line; *p && *p != '\n' && *p != '\r'; p++) {
+        if (*p == ',') {
+            out.push_back(cur);
+            cur.clear();
+        } else if (*p != ' ' && *p != '"') {
+            cur += *p;
+        }
+    }
+    out.push_back(cur);
+    return out;
+}
+
+static int record(const char* csvPath, const char* outPath, std::string stepCol[AXES], std::string dirCol[AXES]) {
+    FILE* in = fopen(csvPath, "r");
+    if (!in) {
+        perror(csvPath);
+        return 2;
+    }
+
+    char line[1024];
+    std::vector<std::string> header;
+    while (fgets(line, sizeof(line), in)) {
+        if (line[0] != ';' && line[0] != '#' && line[0] != '\n') {
+            header = splitCsv(line);
+            break;
+        }
+    }
+
+    int stepIdx[AXES], dirIdx[AXES];
+    for (int a = 0; a < AXES; a++) {
+        stepIdx[a] = stepCol[a].empty() ? -1 : findColumn(header, stepCol[a]);
+        dirIdx[a]  = dirCol[a].empty()  ? -1 : findColumn(header, dirCol[a]);
+        if (!stepCol[a].empty() && (stepIdx[a] < 0 || dirIdx[a] < 0)) {
+            fprintf(stderr, "%s: columns %s,%s not found\n", kAxisName[a], stepCol[a].c_str(), dirCol[a].c_str());
+            fclose(in);
+            return 2;
+        }
+    }
+
+    FILE* out = fopen(outPath, "w");
+    if (!out) {
+        perror(outPath);
+        fclose(in);
+        return 2;
+    }
+    fprintf(out, "# stepTrace 1\n");
+
+    int    lastStep[AXES] = { 0, 0, 0 };
+    long   steps[AXES]    = { 0, 0, 0 };
+    double t0 = -1;
+    while (fgets(line, sizeof(line), in)) {
+        if (line[0] == ';' || line[0] == '#') {
+            continue;
+        }
+        std::vector<std::string> v = splitCsv(line);
+        if (v.size() < header.size()) {
+            continue;
+        }
+        double us = atof(v[0].c_str()) * 1e6;
+        if (t0 < 0) {
+            t0 = us;
+        }
+        for (int a = 0; a < AXES; a++) {
+            if (stepIdx[a] < 0) continue;
+            int s = atoi(v[stepIdx[a]].c_str()) != 0;
+            if (s && !lastStep[a]) {  // steppers step on the rising edge
+                fprintf(out, "%s %.1f %d\n", kAxisName[a], us - t0, atoi(v[dirIdx[a]].c_str()) != 0);
+                steps[a]++;
+            }
+            lastStep[a] = s;
+        }
+    }
+    fclose(in);
+    fclose(out);
+
+    for (int a = 0; a < AXES; a++) {
+        if (stepIdx[a] >= 0) {
+            printf("%-3s %ld steps\n", kAxisName[a], steps[a]);
+        }
+    }
+    return 0;
+}
+
+// ---------------- Timeline comparison ----------------
+
+static bool loadTimeline(const char* path, Timeline& tl) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        char   name[8];
+        double us;
+        int    dir;
+        if (line[0] == '#' || sscanf(line, "%7s %lf %d", name, &us, &dir) != 3) {
+            continue;
+        }
+        for (int a = 0; a < AXES; a++) {
+            if (strcmp(name, kAxisName[a]) == 0) {
+                Step s = { us, dir };
+                tl.axis[a].push_back(s);
+            }
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+static std::vector<Move> splitMoves(const std::vector<Step>& steps, double gapUs) {
+    std::vector<Move> moves;
+    for (size_t i = 0; i < steps.size(); i++) {
+        if (i == 0 || steps[i].us - steps[i - 1].us > gapUs || steps[i].dir != steps[i - 1].dir) {
+            Move m = { i, 0, steps[i].us, steps[i].us, 0 };
+            moves.push_back(m);
+        }
+        Move& m = moves.back();
+        m.count++;
+        m.end = steps[i].us;
+        m.net += steps[i].dir ? 1 : -1;
+    }
+    return moves;
+}
+
+static void cycleSpan(const Timeline& tl, double& first, double& last) {
+    first = -1;
+    last  = -1;
+    for (int a = 0; a < AXES; a++) {
+        if (tl.axis[a].empty()) continue;
+        if (first < 0 || tl.axis[a].front().us < first) first = tl.axis[a].front().us;
+        if (tl.axis[a].back().us > last) last = tl.axis[a].back().us;
+    }
+}
+
+static int compare(const char* goldenPath, const char* newPath, double tolUs, double tolPct, double gapUs) {
+    Timeline g, n;
+    if (!loadTimeline(goldenPath, g) || !loadTimeline(newPath, n)) {
+        return 2;
+    }
+
+    double g0, g1, n0, n1;
+    cycleSpan(g, g0, g1);
+    cycleSpan(n, n0, n1);
+    if (g0 < 0 || n0 < 0) {
+        fprintf(stderr, "empty timeline\n");
+        return 2;
+    }
+
+    bool fail = false;
+    printf("%-3s %4s %7s %7s %10s %10s %10s  %s\n",
+           "ax", "move", "steps", "net", "start ms", "dur ms", "worst us", "");
+
+    for (int a = 0; a < AXES; a++) {
+        std::vector<Move> gm = splitMoves(g.axis[a], gapUs);
+        std::vector<Move> nm = splitMoves(n.axis[a], gapUs);
+        if (gm.size() != nm.size()) {
+            printf("%-3s move count %d -> %d  FAIL\n", kAxisName[a], (int)gm.size(), (int)nm.size());
+            fail = true;
+        }
+
+        size_t pairs = gm.size() < nm.size() ? gm.size() : nm.size();
+        for (size_t i = 0; i < pairs; i++) {
+            const Move& x = gm[i];
+            const Move& y = nm[i];
+
+            // Worst deviation of the k-th step, both moves aligned at their first step
+            double worst = 0;
+            size_t k = x.count < y.count ? x.count : y.count;
+            for (size_t j = 0; j < k; j++) {
+                double d = fabs((n.axis[a][y.first + j].us - y.start) - (g.axis[a][x.first + j].us - x.start));
+                if (d > worst) worst = d;
+            }
+
+            bool bad = (x.count != y.count) || (x.net != y.net) || worst > tolUs;
+            fail = fail || bad;
+            printf("%-3s %4d %7ld %7ld %+10.2f %+10.2f %10.0f  %s\n",
+                   kAxisName[a], (int)i, (long)y.count - (long)x.count, y.net - x.net,
+                   ((y.start - n0) - (x.start - g0)) / 1000.0,
+                   ((y.end - y.start) - (x.end - x.start)) / 1000.0,
+                   worst, bad ? "FAIL" : "ok");
+        }
+    }
+
+    double gc = g1 - g0;
+    double nc = n1 - n0;
+    double pct = gc > 0 ? 100.0 * (nc - gc) / gc : 0;
+    bool slow = fabs(pct) > tolPct;
+    fail = fail || slow;
+    printf("\nCycle time: %.3f s -> %.3f s (%+.2f%%)  %s\n", gc * 1e-6, nc * 1e-6, pct, slow ? "FAIL" : "ok");
+    printf("Columns are new minus golden; start is relative to the first step of the run.\n");
+    printf("%s\n", fail ? "REGRESSION" : "MATCH");
+    return fail ? 1 : 0;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: stepTrace record capture.csv -o run.trc [-x1 STEP,DIR] [-x2 STEP,DIR] [-y STEP,DIR]\n"
+            "       stepTrace compare golden.trc run.trc [--tol-us N] [--tol-pct P] [--gap-ms M]\n");
+}
+
+static void splitPair(const char* arg, std::string& a, std::string& b) {
+    const char* c = strchr(arg, ',');
+    a = c ? std::string(arg, c - arg) : std::string(arg);
+    b = c ? std::string(c + 1) : std::string();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        usage();
+        return 2;
+    }
+
+    if (strcmp(argv[1], "record") == 0) {
+        std::string stepCol[AXES] = { "D2", "", "D3" };
+        std::string dirCol[AXES]  = { "D5", "", "D6" };
+        const char* out = 0;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if      (strcmp(argv[i], "-o") == 0)  out = argv[i + 1];
+            else if (strcmp(argv[i], "-x1") == 0) splitPair(argv[i + 1], stepCol[0], dirCol[0]);
+            else if (strcmp(argv[i], "-x2") == 0) splitPair(argv[i + 1], stepCol[1], dirCol[1]);
+            else if (strcmp(argv[i], "-y") == 0)  splitPair(argv[i + 1], stepCol[2], dirCol[2]);
+            else { usage(); return 2; }
+        }
+        if (!out) {
+            usage();
+            return 2;
+        }
+        return record(argv[2], out, stepCol, dirCol);
+    }
+
+    if (strcmp(argv[1], "compare") == 0 && argc >= 4) {
+        double tolUs = 500, tolPct = 1, gapMs = 20;
+        for (int i = 4; i + 1 < argc; i += 2) {
+            if      (strcmp(argv[i], "--tol-us") == 0)  tolUs  = atof(argv[i + 1]);
+            else if (strcmp(argv[i], "--tol-pct") == 0) tolPct = atof(argv[i + 1]);
+            else if (strcmp(argv[i], "--gap-ms") == 0)  gapMs  = atof(argv[i + 1]);
+            else { usage(); return 2; }
+        }
+        return compare(argv[2], argv[3], tolUs, tolPct, gapMs * 1000);
+    }
+
+    usage();
+    return 2;
+}
@@ -0,0 +1,287 @@
+/*
+  traceFit: calibrates the host timing model (simModel.h) from device traces.
+
+  Reads Serial logs captured with TIMING_TRACE (goodEnough/timingTrace.h);
+  any other lines, and anything before the "T" on a line (logger
+  timestamps), are ignored. Fits:
+    - per axis: effective step-rate ceiling and fixed per-move overhead
+      (grid search over the ceiling, least-squares overhead for each)
+    - LCD cost per expander byte (least squares through the origin)
+    - probe move time beyond its profile (mean offset)
+  then reports, per traced run, the modelled time (moves + probe + LCD)
+  predicted by the nominal and by the calibrated model against the
+  measured one.
+
+  Build and run from the repo root:
+      g++ -O2 -std=c++11 -o traceFit tools/traceFit.cpp
+      ./traceFit [-o simCal.txt] trace1.log [trace2.log ...]   (stdin if no files)
+  profileSim then takes simCal.txt as its argument.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "simModel.h"
+
+struct MoveRec {
+    char  axis;
+    float steps;
+    float maxVel;
+    float accel;
+    float seconds;
+    int   run;
+};
+
+struct ServoRec {
+    float seconds;
+    float profile;   // profile travel time (s)
+    int   run;
+};
+
+struct LcdRec {
+    float bytes;
+    float us;
+    int   run;
+};
+
+struct RunRec {
+    std::string name;
+    float wall;      // s, 0 if the run did not end cleanly
+    float maxGapUs;
+    float meanGapUs;
+};
+
+static std::vector<MoveRec>  gMoves;
+static std::vector<ServoRec> gServos;
+static std::vector<LcdRec>   gLcd;
+static std::vector<RunRec>   gRuns;
+
+static void parseLine(const char* line) {
+    const char* t = strchr(line, 'T');
+    while (t && !(t[1] && strchr("JMSLE", t[1]) && t[2] == ',')) {
+        t = strchr(t + 1, 'T');
+    }
+    if (!t) {
+        return;
+    }
+    const char* a = t + 3;
+    int run = (int)gRuns.size() - 1;
+
+    if (t[1] == 'J') {
+        RunRec r;
+        char name[32] = "";
+        sscanf(a, "%31[^\r\n]", name);
+        r.name = name;
+        r.wall = r.maxGapUs = r.meanGapUs = 0;
+        gRuns.push_back(r);
+        return;
+    }
+    if (run < 0) {
+        return;     // events before the first TJ
+    }
+
+    if (t[1] == 'M') {
+        MoveRec m;
+        long steps;
+        unsigned long us, gap;
+        if (sscanf(a, "%c,%ld,%f,%f,%lu,%lu", &m.axis, &steps, &m.maxVel, &m.accel, &us, &gap) == 6) {
+            m.steps   = fabs((float)steps);
+            m.seconds = us * 1e-6f;
+            m.run     = run;
+            gMoves.push_back(m);
+        }
+    } else if (t[1] == 'S') {
+        float from, to;
+        unsigned long us, ms;
+        if (sscanf(a, "%f,%f,%lu,%lu", &from, &to, &us, &ms) == 4) {
+            ServoRec s = { us * 1e-6f, ms * 1e-3f, run };
+            gServos.push_back(s);
+        }
+    } else if (t[1] == 'L') {
+        unsigned long bytes, us;
+        if (sscanf(a, "%lu,%lu", &bytes, &us) == 2) {
+            LcdRec l = { (float)bytes, (float)us, run };
+            gLcd.push_back(l);
+        }
+    } else if (t[1] == 'E') {
+        unsigned long us, maxGap, meanGap;
+        if (sscanf(a, "%lu,%lu,%lu", &us, &maxGap, &meanGap) == 3) {
+            gRuns[run].wall      = us * 1e-6f;
+            gRuns[run].maxGapUs  = (float)maxGap;
+            gRuns[run].meanGapUs = (float)meanGap;
+        }
+    }
+}
+
+static void readFile(FILE* f) {
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        parseLine(line);
+    }
+}
+
+/*
+  fitAxis():
+  For every candidate ceiling the best overhead is the mean residual; keeps
+  the ceiling with the smallest squared error. Ceilings the traced moves never
+  reach fit equally well, so ties go to the higher one; a ceiling at or above
+  every traced maxVel changes nothing and is reported as 0 (none).
+*/
+static void fitAxis(char axis, float& rate, float& overhead, float& rms, int& count) {
+    float top = 0;
+    count = 0;
+    for (size_t i = 0; i < gMoves.size(); i++) {
+        if (gMoves[i].axis == axis) {
+            count++;
+            if (gMoves[i].maxVel > top) top = gMoves[i].maxVel;
+        }
+    }
+    rate = 0;
+    overhead = 0;
+    rms = 0;
+    if (count == 0) {
+        return;
+    }
+
+    double bestSse = -1;
+    for (float cap = 100.0f; ; cap *= 1.005f) {
+        bool last = cap >= top;
+        float c = last ? 0 : cap;
+
+        SimModel m = simModelNominal();
+        m.stepRateX = m.stepRateY = c;
+        double sum = 0, sum2 = 0;
+        for (size_t i = 0; i < gMoves.size(); i++) {
+            const MoveRec& mv = gMoves[i];
+            if (mv.axis != axis) continue;
+            double r = mv.seconds - simMoveTime(m, axis, mv.steps, mv.maxVel, mv.accel);
+            sum  += r;
+            sum2 += r * r;
+        }
+        double mean = sum / count;
+        double sse  = sum2 - count * mean * mean;
+        if (bestSse < 0 || sse <= bestSse * (1 + 1e-6) + 1e-12) { // ties go to the higher ceiling
+            bestSse  = sse;
+            rate     = c;
+            overhead = (float)mean;
+        }
+        if (last) {
+            break;
+        }
+    }
+    rms = (float)sqrt((bestSse > 0 ? bestSse : 0) / count);
+}
+
+// Modelled time of one run (moves + probe + LCD) under model m
+static double runPredicted(int run, const SimModel& m) {
+    double t = 0;
+    for (size_t i = 0; i < gMoves.size(); i++) {
+        const MoveRec& mv = gMoves[i];
+        if (mv.run == run) t += simMoveTime(m, mv.axis, mv.steps, mv.maxVel, mv.accel);
+    }
+    for (size_t i = 0; i < gServos.size(); i++) {
+        if (gServos[i].run == run) t += gServos[i].profile + m.servoOffset;
+    }
+    for (size_t i = 0; i < gLcd.size(); i++) {
+        if (gLcd[i].run == run) t += gLcd[i].bytes * m.lcdUsPerByte * 1e-6;
+    }
+    return t;
+}
+
+static double runMeasured(int run) {
+    double t = 0;
+    for (size_t i = 0; i < gMoves.size(); i++)  if (gMoves[i].run == run)  t += gMoves[i].seconds;
+    for (size_t i = 0; i < gServos.size(); i++) if (gServos[i].run == run) t += gServos[i].seconds;
+    for (size_t i = 0; i < gLcd.size(); i++)    if (gLcd[i].run == run)    t += gLcd[i].us * 1e-6;
+    return t;
+}
+
+int main(int argc, char** argv) {
+    const char* out = 0;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out = argv[++i];
+            continue;
+        }
+        FILE* f = fopen(argv[i], "r");
+        if (!f) {
+            perror(argv[i]);
+            return 1;
+        }
+        readFile(f);
+        fclose(f);
+        files++;
+    }
+    if (files == 0) {
+        readFile(stdin);
+    }
+    if (gRuns.empty()) {
+        fprintf(stderr, "no TJ lines found (build with TIMING_TRACE)\n");
+        return 1;
+    }
+
+    SimModel nominal = simModelNominal();
+    SimModel cal     = nominal;
+
+    float rmsX, rmsY;
+    int   nX, nY;
+    fitAxis('X', cal.stepRateX, cal.overheadX, rmsX, nX);
+    fitAxis('Y', cal.stepRateY, cal.overheadY, rmsY, nY);
+
+    double sxy = 0, sxx = 0;
+    for (size_t i = 0; i < gLcd.size(); i++) {
+        sxy += gLcd[i].bytes * gLcd[i].us;
+        sxx += gLcd[i].bytes * gLcd[i].bytes;
+    }
+    if (sxx > 0) {
+        cal.lcdUsPerByte = (float)(sxy / sxx);
+    }
+
+    double soff = 0;
+    for (size_t i = 0; i < gServos.size(); i++) {
+        soff += gServos[i].seconds - gServos[i].profile;
+    }
+    if (!gServos.empty()) {
+        cal.servoOffset = (float)(soff / gServos.size());
+    }
+
+    printf("Samples: %d X moves, %d Y moves, %d probe moves, %d LCD writes, %d runs\n\n",
+           nX, nY, (int)gServos.size(), (int)gLcd.size(), (int)gRuns.size());
+    printf("%-14s %12s %12s\n", "parameter", "nominal", "calibrated");
+    printf("%-14s %12g %12g   (rms residual %.1f ms)\n", "stepRateX", nominal.stepRateX, cal.stepRateX, rmsX * 1e3);
+    printf("%-14s %12g %12g   (rms residual %.1f ms)\n", "stepRateY", nominal.stepRateY, cal.stepRateY, rmsY * 1e3);
+    printf("%-14s %12g %12g\n", "overheadX s", nominal.overheadX, cal.overheadX);
+    printf("%-14s %12g %12g\n", "overheadY s", nominal.overheadY, cal.overheadY);
+    printf("%-14s %12g %12g\n", "lcdUsPerByte", nominal.lcdUsPerByte, cal.lcdUsPerByte);
+    printf("%-14s %12g %12g\n", "servoOffset s", nominal.servoOffset, cal.servoOffset);
+
+    printf("\n%-10s %9s %9s %8s %9s %8s %9s %8s\n",
+           "run", "measured", "nominal", "err", "calib", "err", "wall", "maxGap");
+    for (int r = 0; r < (int)gRuns.size(); r++) {
+        double meas = runMeasured(r);
+        double pn   = runPredicted(r, nominal);
+        double pc   = runPredicted(r, cal);
+        printf("%-10s %9.3f %9.3f %7.1f%% %9.3f %7.1f%% %9.3f %6.0fus\n",
+               gRuns[r].name.c_str(), meas,
+               pn, meas > 0 ? 100.0 * (pn - meas) / meas : 0.0,
+               pc, meas > 0 ? 100.0 * (pc - meas) / meas : 0.0,
+               gRuns[r].wall, gRuns[r].maxGapUs);
+    }
+    printf("\nTimes in s; 'wall' includes operator and settle time, which are not modelled.\n");
+
+    if (out) {
+        if (!simModelSave(out, cal)) {
+            perror(out);
+            return 1;
+        }
+        printf("Calibration written to %s\n", out);
+    }
+    return 0;
+}